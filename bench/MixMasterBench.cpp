@@ -0,0 +1,818 @@
+//***********************************************************************************************
+//Mind Meld Modular: Modules for VCV Rack by Steve Baker and Marc Boulé
+//
+//See ./LICENSE.md for all licenses
+//***********************************************************************************************
+
+// Headless DSP benchmark for MixMaster (16 tracks, 4 groups) and MixMasterJr (8 tracks, 2 groups).
+// Compiles the MixerTrack, MixerGroup, MixerAux and MixerMaster structs from src/MixMaster.hpp against
+// the minimal Rack stub in ./stub, drives them with synthetic mono, stereo and poly inputs, and reports
+// the time spent per sample for a set of scenarios (eco mode, filters, linked faders, solo).
+// Also times the 24 TrackEq instances of EqMaster (src/EqMasterCommon.hpp) with the same inputs.
+// A chain of four MixMasters is also run serially and with one thread per mixer, as Rack's engine threads would, to check
+// that instances share no state (identical output) and to time the threaded chain.
+// A few functional checks run first; the exit status is 1 when one of them fails.
+// See bench/Makefile for build and run instructions.
+
+
+#include <time.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "MixerCommon.hpp"
+#include "VuMeters.hpp"
+#include "EqMasterCommon.hpp"
+
+
+Plugin *pluginInstance = NULL;
+
+static engine::Engine benchEngine;
+static app::Window benchWindow;
+static app::Context benchContext = {&benchEngine, &benchWindow};
+app::Context *rack::app::contextGet() {
+	return &benchContext;
+}
+
+
+// Mirrors the module in src/MixMaster.cpp without the widget, expander and message bus parts,
+// such that the DSP structs are included the same way
+template<int N_TRK, int N_GRP>
+struct BenchMixMaster : Module {
+
+	enum ParamIds {
+		ENUMS(TRACK_FADER_PARAMS, N_TRK),
+		ENUMS(GROUP_FADER_PARAMS, N_GRP),// must follow TRACK_FADER_PARAMS since code assumes contiguous
+		ENUMS(TRACK_PAN_PARAMS, N_TRK),
+		ENUMS(GROUP_PAN_PARAMS, N_GRP),
+		ENUMS(TRACK_MUTE_PARAMS, N_TRK),
+		ENUMS(GROUP_MUTE_PARAMS, N_GRP),// must follow TRACK_MUTE_PARAMS since code assumes contiguous
+		ENUMS(TRACK_SOLO_PARAMS, N_TRK),// must follow GROUP_MUTE_PARAMS since code assumes contiguous
+		ENUMS(GROUP_SOLO_PARAMS, N_GRP),// must follow TRACK_SOLO_PARAMS since code assumes contiguous
+		MAIN_MUTE_PARAM,// must follow GROUP_SOLO_PARAMS since code assumes contiguous
+		MAIN_DIM_PARAM,// must follow MAIN_MUTE_PARAM since code assumes contiguous
+		MAIN_MONO_PARAM,// must follow MAIN_DIM_PARAM since code assumes contiguous
+		MAIN_FADER_PARAM,
+		ENUMS(GROUP_SELECT_PARAMS, N_TRK),
+		ENUMS(TRACK_HPCUT_PARAMS, N_TRK),
+		ENUMS(TRACK_LPCUT_PARAMS, N_TRK),
+		ENUMS(GROUP_HPCUT_PARAMS, N_GRP),
+		ENUMS(GROUP_LPCUT_PARAMS, N_GRP),
+		NUM_PARAMS
+	};
+
+	enum InputIds {
+		ENUMS(TRACK_SIGNAL_INPUTS, N_TRK * 2), // Track 0: 0 = L, 1 = R, Track 1: 2 = L, 3 = R, etc...
+		ENUMS(TRACK_VOL_INPUTS, N_TRK),
+		ENUMS(GROUP_VOL_INPUTS, N_GRP),
+		ENUMS(TRACK_PAN_INPUTS, N_TRK),
+		ENUMS(GROUP_PAN_INPUTS, N_GRP),
+		ENUMS(CHAIN_INPUTS, 2),
+		ENUMS(INSERT_TRACK_INPUTS, N_TRK / 8),
+		INSERT_GRP_AUX_INPUT,
+		ENUMS(TRACK_MUTESOLO_INPUTS, 2),
+		GRPM_MUTESOLO_INPUT,// 1-4 Group mutes, 5-8 Group solos, 9 Master Mute, 10 Master Dim, 11 Master Mono, 12 Master VOL
+		NUM_INPUTS
+	};
+
+	enum OutputIds {
+		ENUMS(DIRECT_OUTPUTS, N_TRK / 8 + 1), // Track 1-8, (Track 9-16), Groups and Aux
+		ENUMS(MAIN_OUTPUTS, 2),
+		ENUMS(INSERT_TRACK_OUTPUTS, N_TRK / 8),
+		INSERT_GRP_AUX_OUTPUT,
+		FADE_CV_OUTPUT,
+		NUM_OUTPUTS
+	};
+
+	typedef TAfmExpInterface<N_TRK, N_GRP> AfmExpInterface;
+
+
+	#include "MixMaster.hpp"
+
+
+	// No need to save, no reset
+	alignas(4) char trackLabels[4 * (N_TRK + N_GRP) + 4];
+	GlobalInfo gInfo;
+	MixerTrack tracks[N_TRK];
+	MixerTrackSimd trackSimd;
+	MixerTrackFilterBank trackFilters;
+	MixerGroup groups[N_GRP];
+	MixerAux aux[4];
+	MixerMaster master;
+	RefreshCounter refresh;
+	float trackTaps[N_TRK * 2 * 4];
+	float trackInsertOuts[N_TRK * 2];
+	float trackInsertIns[N_TRK * 2];
+	uint32_t activeTrackMask = 0;
+	int activeTracks[N_TRK];
+	int numActiveTracks = 0;
+	float groupTaps[N_GRP * 2 * 4];
+	float groupInsertOuts[N_GRP * 2];
+	float auxTaps[4 * 2 * 4];
+	float values20[20] = {0.0f};
+	PackedBytes4 stereoPanModeLocalAux;
+	// stands in for the aux-expander
+	bool auxExpanderPresent = false;
+	float auxReturns[8] = {0.0f};
+	float auxRetFadePanFadecv[12] = {0.0f};
+
+
+	BenchMixMaster() {
+		config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, 0);
+		for (int i = 0; i < N_TRK; i++) {
+			params[TRACK_PAN_PARAMS + i].setValue(0.5f);
+			params[TRACK_FADER_PARAMS + i].setValue(1.0f);
+			params[TRACK_HPCUT_PARAMS + i].setValue(GlobalConst::defHPFCutoffFreq);
+			params[TRACK_LPCUT_PARAMS + i].setValue(GlobalConst::defLPFCutoffFreq);
+		}
+		for (int i = 0; i < N_GRP; i++) {
+			params[GROUP_PAN_PARAMS + i].setValue(0.5f);
+			params[GROUP_FADER_PARAMS + i].setValue(1.0f);
+			params[GROUP_HPCUT_PARAMS + i].setValue(GlobalConst::defHPFCutoffFreq);
+			params[GROUP_LPCUT_PARAMS + i].setValue(GlobalConst::defLPFCutoffFreq);
+		}
+		params[MAIN_FADER_PARAM].setValue(1.0f);
+		stereoPanModeLocalAux.cc1 = 0;
+
+		gInfo.construct(&params[0], values20);
+		trackLabels[4 * (N_TRK + N_GRP)] = 0;
+		for (int i = 0; i < N_TRK; i++) {
+			tracks[i].construct(i, &gInfo, &inputs[0], &params[0], &(trackLabels[4 * i]), &trackTaps[i << 1], groupTaps, &trackInsertOuts[i << 1], &trackInsertIns[i << 1]);
+		}
+		trackSimd.construct(&gInfo, tracks, trackTaps, groupTaps);
+		trackFilters.construct(&gInfo, tracks, trackTaps);
+		for (int i = 0; i < N_GRP; i++) {
+			groups[i].construct(i, &gInfo, &inputs[0], &params[0], &(trackLabels[4 * (N_TRK + i)]), &groupTaps[i << 1], &groupInsertOuts[i << 1]);
+		}
+		for (int i = 0; i < 4; i++) {
+			aux[i].construct(i, &gInfo, &inputs[0], values20, &auxTaps[i << 1], &stereoPanModeLocalAux.cc4[i]);
+		}
+		master.construct(&gInfo, &params[0], &inputs[0]);
+		onReset();
+	}
+
+
+	void onReset() override {
+		gInfo.onReset();
+		for (int i = 0; i < N_TRK; i++) {
+			tracks[i].onReset();
+		}
+		for (int i = 0; i < N_GRP; i++) {
+			groups[i].onReset();
+		}
+		for (int i = 0; i < 4; i++) {
+			aux[i].onReset();
+		}
+		master.onReset();
+		trackSimd.reset();
+		trackFilters.reset();
+	}
+
+
+	void onSampleRateChange() override {
+		gInfo.sampleTime = APP->engine->getSampleTime();
+		for (int trk = 0; trk < N_TRK; trk++) {
+			tracks[trk].onSampleRateChange();
+		}
+		for (int grp = 0; grp < N_GRP; grp++) {
+			groups[grp].onSampleRateChange();
+		}
+		master.onSampleRateChange();
+		trackFilters.onSampleRateChange();
+	}
+
+
+	void processSlow() {
+		if (refresh.processInputs()) {
+			int sixteenCount = refresh.refreshCounter >> 4;
+
+			// Tracks
+			int trackToProcess = (N_TRK == 16 ? sixteenCount : (sixteenCount & 0x7));
+			gInfo.updateSoloBit(trackToProcess);
+			tracks[trackToProcess].updateSlowValues();
+			trackFilters.updateSlowValues(trackToProcess);
+			// Groups
+			if ( (sixteenCount & 0x3) == 0) {
+				int groupToProcess = sixteenCount >> (4 - N_GRP / 2);
+				gInfo.updateSoloBit(N_TRK + groupToProcess);
+				groups[groupToProcess].updateSlowValues();
+			}
+			// Aux
+			if ( auxExpanderPresent && ((sixteenCount & 0x3) == 1) ) {
+				gInfo.updateReturnSoloBits();
+				aux[sixteenCount >> 2].updateSlowValues();
+			}
+			// Master
+			if ((sixteenCount & 0x3) == 2) {
+				master.updateSlowValues();
+				gInfo.updateGroupUsage();
+			}
+
+			// Active tracks, as in MixMaster::UpdateActiveTracks()
+			uint32_t mask = 0;
+			for (int trk = 0; trk < N_TRK; trk++) {
+				if (inputs[TRACK_SIGNAL_INPUTS + 2 * trk].isConnected()) {
+					mask |= (1 << trk);
+				}
+			}
+			if (mask != activeTrackMask) {
+				activeTrackMask = mask;
+				numActiveTracks = 0;
+				for (int trk = 0; trk < N_TRK; trk++) {
+					if ((mask & (1 << trk)) != 0) {
+						activeTracks[numActiveTracks++] = trk;
+					}
+				}
+			}
+			for (int trk = 0; trk < N_TRK; trk++) {
+				if ((activeTrackMask & (1 << trk)) == 0) {
+					tracks[trk].processEcoControls(RefreshCounter::userInputsStepSkipMask + 1);
+					tracks[trk].processUnused();
+				}
+			}
+		}
+	}
+
+
+	// Same sequence as MixMaster::process(), minus lights, direct/insert outs and expander messages
+	void process(const ProcessArgs &args) override {
+		processSlow();
+
+		uint16_t ecoCode = (refresh.refreshCounter & 0x3 & gInfo.ecoMode);
+		bool ecoStagger4 = (gInfo.ecoMode == 0 || ecoCode == 3);
+
+		float mix[2] = {0.0f};
+		for (int i = 0; i < (N_GRP << 1); i++) {
+			groupTaps[i] = 0.0f;
+		}
+
+		gInfo.process();
+		for (int base = 0; base < N_TRK; base += 8) {
+			if (inputs[INSERT_TRACK_INPUTS + (base >> 3)].isConnected()) {
+				float* voltages = inputs[INSERT_TRACK_INPUTS + (base >> 3)].getVoltages();
+				simd::float_4 numChannels = (float)inputs[INSERT_TRACK_INPUTS + (base >> 3)].getChannels();
+				simd::float_4 channelIndex = simd::float_4(0.0f, 1.0f, 2.0f, 3.0f);
+				for (int i = 0; i < 16; i += 4) {
+					simd::float_4 inUse = (channelIndex + (float)i) < numChannels;
+					clamp20V(simd::float_4::load(&voltages[i]) & inUse).store(&trackInsertIns[(base << 1) + i]);
+				}
+			}
+		}
+		for (int i = 0; i < numActiveTracks; i++) {
+			tracks[activeTracks[i]].processPreFilter(ecoCode == 0);// stagger 1
+		}
+		trackFilters.process();
+		for (int i = 0; i < numActiveTracks; i++) {
+			MixerTrack* track = &tracks[activeTracks[i]];
+			if (track->oldInUse) {
+				track->processPostFilter(ecoCode == 0);// stagger 1
+			}
+		}
+		trackSimd.process(mix, ecoCode == 0);// stagger 1
+		bool ecoStagger3 = (gInfo.ecoMode == 0 || ecoCode == 2);
+		if (auxExpanderPresent) {
+			for (int auxi = 0; auxi < 4; auxi++) {
+				int auxGroup = aux[auxi].getAuxGroup();
+				if (auxGroup != 0) {
+					auxGroup--;
+					aux[auxi].process(&groupTaps[auxGroup << 1], &auxRetFadePanFadecv[auxi], ecoStagger3);// stagger 3
+				}
+			}
+		}
+		bool ecoStagger2 = (gInfo.ecoMode == 0 || ecoCode == 1);
+		for (int i = 0; i < N_GRP; i++) {
+			groups[i].process(mix, ecoStagger2);// stagger 2
+		}
+		if (auxExpanderPresent) {
+			memcpy(auxTaps, auxReturns, 8 * 4);
+			for (int auxi = 0; auxi < 4; auxi++) {
+				if (aux[auxi].getAuxGroup() == 0) {
+					aux[auxi].process(mix, &auxRetFadePanFadecv[auxi], ecoStagger3);// stagger 3
+				}
+			}
+		}
+		master.process(mix, ecoStagger4);// stagger 4
+
+		outputs[MAIN_OUTPUTS + 0].setVoltage(mix[0]);
+		outputs[MAIN_OUTPUTS + 1].setVoltage(mix[1]);
+
+		refresh.processLights();
+	}
+};
+
+
+//*****************************************************************************
+
+
+struct Scenario {
+	const char *name;
+	bool eco;
+	bool filters;
+	bool linked;
+	bool solo;
+	bool auxRet;
+	bool inserts;// track insert inputs connected
+	bool mono;// all track inputs mono
+};
+
+static const Scenario scenarios[] = {
+	{"eco on",                    true,  false, false, false, false, false, false},
+	{"eco off",                   false, false, false, false, false, false, false},
+	{"eco on, filters on",        true,  true,  false, false, false, false, false},
+	{"eco off, filters on",       false, true,  false, false, false, false, false},
+	{"eco on, linked faders",     true,  false, true,  false, false, false, false},
+	{"eco on, solo",              true,  false, false, true,  false, false, false},
+	{"eco on, aux returns",       true,  false, false, false, true, false, false},
+	{"eco off, filters on, solo", false, true,  false, true,  false, false, false},
+	{"eco on, inserts",           true,  false, false, false, false, true, false},
+	{"eco on, filters on, mono",  true,  true,  false, false, false, false, true},
+};
+
+static double threadTimeNs() {// cpu time of this thread, less sensitive to other load than wall time
+	timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static const int numSigSamples = 4096;// power of 2
+static float sigTable[numSigSamples];
+
+
+template<int N_TRK, int N_GRP>
+static void setupScenario(BenchMixMaster<N_TRK, N_GRP> *mm, const Scenario &sc) {
+	typedef BenchMixMaster<N_TRK, N_GRP> MM;
+	mm->onReset();
+	mm->gInfo.ecoMode = sc.eco ? 0xFFFF : 0;
+	mm->auxExpanderPresent = sc.auxRet;
+	for (int i = 0; i < N_TRK / 8; i++) {
+		mm->inputs[MM::INSERT_TRACK_INPUTS + i].channels = (sc.inserts ? 16 : 0);
+	}
+	for (int a = 0; a < 4; a++) {
+		mm->values20[a + 8] = (float)(a & 0x1);// aux A and C to mix, B and D to group 1
+		mm->auxRetFadePanFadecv[a + 0] = 0.8f;// fader
+		mm->auxRetFadePanFadecv[a + 4] = 0.5f;// pan
+		mm->auxRetFadePanFadecv[a + 8] = 1.0f;// fader cv
+	}
+
+	for (int t = 0; t < N_TRK; t++) {
+		// track inputs: one quarter mono, one quarter stereo, one quarter poly-stereo, one quarter poly mono-sum
+		Input *inL = &mm->inputs[MM::TRACK_SIGNAL_INPUTS + 2 * t + 0];
+		Input *inR = &mm->inputs[MM::TRACK_SIGNAL_INPUTS + 2 * t + 1];
+		int kind = sc.mono ? 0 : (t & 0x3);
+		inL->channels = (kind >= 2 ? 8 : 1);
+		inR->channels = (kind == 1 ? 1 : 0);
+		mm->tracks[t].polyStereo = (kind == 2 ? 1 : 0);
+
+		mm->params[MM::TRACK_PAN_PARAMS + t].setValue(0.2f + 0.6f * t / N_TRK);
+		mm->params[MM::TRACK_FADER_PARAMS + t].setValue(0.8f);
+		mm->params[MM::TRACK_SOLO_PARAMS + t].setValue((sc.solo && (t == 1 || t == 5)) ? 1.0f : 0.0f);
+		mm->params[MM::GROUP_SELECT_PARAMS + t].setValue((float)(t % (N_GRP + 1)));// some tracks grouped, some to mix
+		mm->tracks[t].setHPFCutoffFreq(sc.filters ? 80.0f : GlobalConst::defHPFCutoffFreq);
+		mm->tracks[t].setLPFCutoffFreq(sc.filters ? 12000.0f : GlobalConst::defLPFCutoffFreq);
+		if (sc.linked) {
+			mm->gInfo.setLinked(t);
+		}
+	}
+	for (int g = 0; g < N_GRP; g++) {
+		mm->params[MM::GROUP_FADER_PARAMS + g].setValue(0.9f);
+		mm->params[MM::GROUP_SOLO_PARAMS + g].setValue((sc.solo && g == 0) ? 1.0f : 0.0f);
+		mm->groups[g].setHPFCutoffFreq(sc.filters ? 40.0f : GlobalConst::defHPFCutoffFreq);
+		mm->groups[g].setLPFCutoffFreq(sc.filters ? 15000.0f : GlobalConst::defLPFCutoffFreq);
+	}
+	mm->trackFilters.reset();// pick up the cutoffs set above right away
+	mm->gInfo.updateSoloBitMask();
+	mm->gInfo.updateGroupUsage();
+	for (int i = 0; i < 16 * (N_TRK + N_GRP); i++) {// let the staggered slow updates visit every track and group
+		mm->refresh.refreshCounter = (i << 4) & 0xFF;
+		mm->process(Module::ProcessArgs{benchEngine.getSampleRate(), benchEngine.getSampleTime()});
+	}
+}
+
+
+template<int N_TRK, int N_GRP>
+static void writeTrackInputs(BenchMixMaster<N_TRK, N_GRP> *mm, int s) {
+	// write inputs as a patch cable would: each channel is a shifted read into the signal table
+	for (int i = 0; i < N_TRK * 2; i++) {
+		Input *in = &mm->inputs[BenchMixMaster<N_TRK, N_GRP>::TRACK_SIGNAL_INPUTS + i];
+		for (int c = 0; c < in->channels; c++) {
+			in->voltages[c] = sigTable[(s + i * 37 + c * 101) & (numSigSamples - 1)];
+		}
+	}
+	for (int i = 0; i < N_TRK / 8; i++) {
+		Input *in = &mm->inputs[BenchMixMaster<N_TRK, N_GRP>::INSERT_TRACK_INPUTS + i];
+		for (int c = 0; c < in->channels; c++) {
+			in->voltages[c] = sigTable[(s + i * 43 + c * 71) & (numSigSamples - 1)];
+		}
+	}
+}
+
+
+template<int N_TRK, int N_GRP>
+static void runBench(const char *moduleName, int numSamples, int numRuns) {
+	typedef BenchMixMaster<N_TRK, N_GRP> MM;
+	MM *mm = new MM;
+	const Module::ProcessArgs args{benchEngine.getSampleRate(), benchEngine.getSampleTime()};
+
+	printf("%s (%i tracks, %i groups), %i samples per scenario, best of %i\n", moduleName, N_TRK, N_GRP, numSamples, numRuns);
+	for (const Scenario &sc : scenarios) {
+		double bestNs = 1e30;
+		double checksum = 0.0;
+		for (int run = 0; run < numRuns; run++) {// best of numRuns, to reduce scheduling noise
+			setupScenario<N_TRK, N_GRP>(mm, sc);
+			checksum = 0.0;
+
+			double start = threadTimeNs();
+			for (int s = 0; s < numSamples; s++) {
+				writeTrackInputs<N_TRK, N_GRP>(mm, s);
+				if (sc.auxRet) {
+					for (int i = 0; i < 8; i++) {
+						mm->auxReturns[i] = sigTable[(s + i * 53) & (numSigSamples - 1)];
+					}
+				}
+				if (sc.linked && (s & 0xFFF) == 0) {// move the first linked fader every 4096 samples
+					mm->params[MM::TRACK_FADER_PARAMS].setValue(0.5f + 0.4f * (float)((s >> 12) & 0x1));
+				}
+				mm->process(args);
+				checksum += mm->outputs[MM::MAIN_OUTPUTS + 0].getVoltage() + mm->outputs[MM::MAIN_OUTPUTS + 1].getVoltage();
+			}
+			bestNs = std::min(bestNs, threadTimeNs() - start);
+		}
+
+		double nsPerSample = bestNs / numSamples;
+		double cpuPercent = nsPerSample * benchEngine.getSampleRate() * 1e-7;// percent of one core at the engine's sample rate
+		printf("  %-28s %8.1f ns/sample  %6.3f %% cpu  (checksum %g)\n", sc.name, nsPerSample, cpuPercent, checksum);
+	}
+	printf("\n");
+	delete mm;
+}
+
+
+// Chain of MixMasters, where the main outputs of each one go to the chain inputs of the next one. Rack's engine steps all 
+// the modules of a sample (in parallel on its threads) and then the cables, so each link of the chain is one sample late 
+// and the mixers of one sample do not depend on each other. The threaded run does the same with one thread per mixer and 
+// a barrier after the modules and after the cables; its output must be identical to the serial run.
+struct SpinBarrier {
+	std::atomic<int> count;
+	std::atomic<int> phase;
+	int numThreads;
+
+	SpinBarrier(int _numThreads) : count(0), phase(0), numThreads(_numThreads) {}
+
+	void wait() {
+		int ph = phase.load(std::memory_order_acquire);
+		if (count.fetch_add(1, std::memory_order_acq_rel) == numThreads - 1) {
+			count.store(0, std::memory_order_relaxed);
+			phase.store(ph + 1, std::memory_order_release);
+			return;
+		}
+		for (int spins = 0; phase.load(std::memory_order_acquire) == ph; spins++) {
+			if (spins > 256) {
+				std::this_thread::yield();// when there are fewer cores than threads
+			}
+		}
+	}
+};
+
+
+static void runChainBench(int numSamples, int numRuns) {
+	typedef BenchMixMaster<16, 4> MM;
+	const int numMixers = 4;
+	const Module::ProcessArgs args{benchEngine.getSampleRate(), benchEngine.getSampleTime()};
+	MM *mms[numMixers];
+	auto stepCables = [&](int k) {// chain inputs of mixer k from the main outputs of mixer k - 1
+		if (k > 0) {
+			mms[k]->inputs[MM::CHAIN_INPUTS + 0].setVoltage(mms[k - 1]->outputs[MM::MAIN_OUTPUTS + 0].getVoltage());
+			mms[k]->inputs[MM::CHAIN_INPUTS + 1].setVoltage(mms[k - 1]->outputs[MM::MAIN_OUTPUTS + 1].getVoltage());
+		}
+	};
+	auto wallTimeNs = []() {
+		return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	};
+
+	printf("MixMaster chain of %i (eco on), %i samples, best of %i, %u hardware threads\n", numMixers, numSamples, numRuns, std::thread::hardware_concurrency());
+	double bestNs[2] = {1e30, 1e30};
+	double checksums[2] = {0.0, 0.0};
+	for (int threaded = 0; threaded < 2; threaded++) {
+		for (int run = 0; run < numRuns; run++) {
+			// new mixers for each run, since onReset() does not clear all the dsp state, so that both passes start from the same state
+			for (int k = 0; k < numMixers; k++) {
+				mms[k] = new MM;
+				if (k > 0) {
+					mms[k]->inputs[MM::CHAIN_INPUTS + 0].channels = 1;
+					mms[k]->inputs[MM::CHAIN_INPUTS + 1].channels = 1;
+				}
+				setupScenario<16, 4>(mms[k], scenarios[0]);
+			}
+			for (int k = 0; k < numMixers; k++) {
+				stepCables(k);
+			}
+			double checksum = 0.0;
+			double start = wallTimeNs();
+			if (threaded == 0) {
+				for (int s = 0; s < numSamples; s++) {
+					for (int k = 0; k < numMixers; k++) {
+						writeTrackInputs<16, 4>(mms[k], s);
+						mms[k]->process(args);
+					}
+					checksum += mms[numMixers - 1]->outputs[MM::MAIN_OUTPUTS + 0].getVoltage() + mms[numMixers - 1]->outputs[MM::MAIN_OUTPUTS + 1].getVoltage();
+					for (int k = numMixers - 1; k > 0; k--) {
+						stepCables(k);
+					}
+				}
+			}
+			else {
+				SpinBarrier barrier(numMixers);
+				std::thread threads[numMixers];
+				for (int k = 0; k < numMixers; k++) {
+					threads[k] = std::thread([&, k]() {
+						for (int s = 0; s < numSamples; s++) {
+							writeTrackInputs<16, 4>(mms[k], s);
+							mms[k]->process(args);
+							if (k == numMixers - 1) {
+								checksum += mms[k]->outputs[MM::MAIN_OUTPUTS + 0].getVoltage() + mms[k]->outputs[MM::MAIN_OUTPUTS + 1].getVoltage();
+							}
+							barrier.wait();
+							stepCables(k);
+							barrier.wait();
+						}
+					});
+				}
+				for (int k = 0; k < numMixers; k++) {
+					threads[k].join();
+				}
+			}
+			bestNs[threaded] = std::min(bestNs[threaded], wallTimeNs() - start);
+			checksums[threaded] = checksum;
+			for (int k = 0; k < numMixers; k++) {
+				delete mms[k];
+			}
+		}
+	}
+	printf("  %-28s %8.1f ns/sample  (checksum %g)\n", "serial", bestNs[0] / numSamples, checksums[0]);
+	printf("  %-28s %8.1f ns/sample  (checksum %g, %s)\n", "one thread per mixer", bestNs[1] / numSamples, checksums[1], checksums[0] == checksums[1] ? "identical" : "DIFFERENT");
+	printf("\n");
+}
+
+
+// Same eq sequence as EqMaster::process() for its 3 poly inputs of 8 stereo tracks, minus the VU and spectrum
+struct BenchEqMaster {
+	TrackEq trackEqs[24];
+	uint32_t cvConnected = 0;
+	float in[3][16];
+	float out[3][16];
+	
+	void reset() {
+		for (int t = 0; t < 24; t++) {
+			trackEqs[t].init(t, benchEngine.getSampleRate(), &cvConnected);
+		}
+	}
+	
+	void process() {
+		for (int i = 0; i < 3; i++) {
+			for (int t = 0; t < 8; t++) {
+				trackEqs[(i << 3) + t].process(&out[i][t << 1], &in[i][t << 1], true);
+			}
+		}
+	}
+};
+
+
+struct EqScenario {
+	const char *name;
+	int activeTracks;// tracks with non-zero band gains, the others are flat (their eqs are bypassed)
+	bool sweep;// freq cvs of the eq'd tracks move every sample, so their coefficients are always being recalculated
+	int coeffUpdateInterval;
+};
+
+static const EqScenario eqScenarios[] = {
+	{"flat",                      0,  false, 4},
+	{"12 tracks eq'd",            12, false, 4},
+	{"24 tracks eq'd",            24, false, 4},
+	{"24 swept, coeffs every 1",  24, true,  1},
+	{"24 swept, coeffs every 4",  24, true,  4},
+	{"24 swept, coeffs every 8",  24, true,  8},
+};
+
+
+static void runEqBench(int numSamples, int numRuns) {
+	BenchEqMaster *eqm = new BenchEqMaster;
+
+	printf("EqMaster (24 track eqs), %i samples per scenario, best of %i\n", numSamples, numRuns);
+	for (const EqScenario &sc : eqScenarios) {
+		double bestNs = 1e30;
+		double checksum = 0.0;
+		for (int run = 0; run < numRuns; run++) {
+			eqm->reset();
+			eqm->cvConnected = (sc.sweep ? 0xFFFFFF : 0);
+			for (int t = 0; t < 24; t++) {
+				eqm->trackEqs[t].setCoeffUpdateInterval(sc.coeffUpdateInterval);
+			}
+			for (int t = 0; t < sc.activeTracks; t++) {
+				for (int b = 0; b < 4; b++) {
+					eqm->trackEqs[t].setGain(b, (float)(((t + b) % 7) * 3 - 9));
+				}
+			}
+			checksum = 0.0;
+
+			double start = threadTimeNs();
+			for (int s = 0; s < numSamples; s++) {
+				for (int i = 0; i < 3; i++) {
+					for (int c = 0; c < 16; c++) {
+						eqm->in[i][c] = sigTable[(s + i * 16 * 37 + c * 37) & (numSigSamples - 1)];
+					}
+				}
+				if (sc.sweep) {
+					for (int t = 0; t < sc.activeTracks; t++) {
+						for (int b = 0; b < 4; b++) {
+							eqm->trackEqs[t].setFreqCv(b, sigTable[((s >> 4) + t * 101 + b * 53) & (numSigSamples - 1)]);
+						}
+					}
+				}
+				eqm->process();
+				checksum += eqm->out[0][0] + eqm->out[1][7] + eqm->out[2][14];
+			}
+			bestNs = std::min(bestNs, threadTimeNs() - start);
+		}
+
+		double nsPerSample = bestNs / numSamples;
+		double cpuPercent = nsPerSample * benchEngine.getSampleRate() * 1e-7;
+		printf("  %-28s %8.1f ns/sample  %6.3f %% cpu  (checksum %g)\n", sc.name, nsPerSample, cpuPercent, checksum);
+	}
+	printf("\n");
+	delete eqm;
+}
+
+
+// QuattroBiQuad kernels alone, direct form I and transposed direct form II, 24 stereo tracks with 4 active bands
+template <bool TDF2>
+static void runBiQuadKernel(const char *name, int numSamples, int numRuns) {
+	TQuattroBiQuad<TDF2> *eqs = new TQuattroBiQuad<TDF2>[24];
+	double bestNs = 1e30;
+	double checksum = 0.0;
+	for (int run = 0; run < numRuns; run++) {
+		for (int t = 0; t < 24; t++) {
+			eqs[t].reset();
+			eqs[t].setParameters(0, QuattroBiQuad::LOWSHELF, 40.0f * benchEngine.getSampleTime(), 1.5f, 1.0f);
+			eqs[t].setParameters(1, QuattroBiQuad::PEAK, 300.0f * benchEngine.getSampleTime(), 0.7f, 2.0f);
+			eqs[t].setParameters(2, QuattroBiQuad::PEAK, 2500.0f * benchEngine.getSampleTime(), 1.3f, 2.0f);
+			eqs[t].setParameters(3, QuattroBiQuad::HIGHSHELF, 10000.0f * benchEngine.getSampleTime(), 0.8f, 1.0f);
+		}
+		checksum = 0.0;
+
+		double start = threadTimeNs();
+		for (int s = 0; s < numSamples; s++) {
+			for (int t = 0; t < 24; t++) {
+				float in[2] = {sigTable[(s + t * 37) & (numSigSamples - 1)], sigTable[(s + t * 37 + 101) & (numSigSamples - 1)]};
+				float out[2];
+				eqs[t].process(out, in);
+				checksum += out[0] + out[1];
+			}
+		}
+		bestNs = std::min(bestNs, threadTimeNs() - start);
+	}
+
+	double nsPerSample = bestNs / numSamples;
+	double cpuPercent = nsPerSample * benchEngine.getSampleRate() * 1e-7;
+	printf("  %-28s %8.1f ns/sample  %6.3f %% cpu  (checksum %g)\n", name, nsPerSample, cpuPercent, checksum);
+	delete[] eqs;
+}
+
+
+// Spectrum compaction of one fft frame into the pixel columns of the analyser and peak smoothing to dB, per fft size
+static void runSpectrumBench(int numRuns) {
+	SpectrumBinLut *lut = new SpectrumBinLut;
+	int fftNMax = 1 << FFT_LOG2_N_MAX;
+	float *fftOut = (float*)pffft_aligned_malloc(fftNMax * 4);
+	float *fftData = (float*)pffft_aligned_malloc(fftNMax * 4);
+	float *specState = (float*)pffft_aligned_malloc(DRAW_BUF_N_2 * 4);
+	float *specDb = (float*)pffft_aligned_malloc(DRAW_BUF_N_2 * 4);
+	for (int x = 0; x < fftNMax; x++) {
+		fftOut[x] = sigTable[(x * 37) & (numSigSamples - 1)];
+	}
+	
+	printf("Spectrum compaction and smoothing (per fft frame), best of %i\n", numRuns);
+	for (int log2N = FFT_LOG2_N_MIN; log2N <= FFT_LOG2_N_MAX; log2N++) {
+		int fftN = 1 << log2N;
+		int numFrames = (1 << 24) / fftN;
+		double bestNs = 1e30;
+		double checksum = 0.0;
+		for (int run = 0; run < numRuns; run++) {
+			checksum = 0.0;
+			for (int i = 0; i < DRAW_BUF_N_2; i++) {
+				specState[i] = 0.0f;
+			}
+			double start = threadTimeNs();
+			for (int f = 0; f < numFrames; f++) {
+				memcpy(fftData, fftOut, fftN * 4);
+				fftData[f & (fftN - 1)] += 1.0f;
+				lut->update(fftN, benchEngine.getSampleRate());
+				int size = lut->compact(fftData);
+				smoothSpectrum(specDb, specState, fftData, size, SPEC_BALL_PEAK, 0.5f, 1.1f * 20.0f * 0.30103f, 10.0f);
+				checksum += specDb[f % size];
+			}
+			bestNs = std::min(bestNs, threadTimeNs() - start);
+		}
+		printf("  fft size %-19i %8.1f ns/frame   %4i columns  (checksum %g)\n", fftN, bestNs / numFrames, lut->getSize(), checksum);
+	}
+	printf("\n");
+	pffft_aligned_free(specDb);
+	pffft_aligned_free(specState);
+	pffft_aligned_free(fftData);
+	pffft_aligned_free(fftOut);
+	delete lut;
+}
+
+
+//*****************************************************************************
+
+
+static int numFailedChecks = 0;
+
+static void check(const char *name, bool ok) {
+	printf("  %-44s %s\n", name, ok ? "ok" : "FAILED");
+	if (!ok) {
+		numFailedChecks++;
+	}
+}
+
+
+static void runChecks() {
+	printf("Checks\n");
+	
+	// EqMaster track label requests: the widget's poll of the mapped mixer must not downgrade an init track refresh
+	int updateTrackLabelRequest = 0;
+	raiseTrackLabelRequest(&updateTrackLabelRequest, 2);// InitializeEqTrackItem
+	raiseTrackLabelRequest(&updateTrackLabelRequest, 1);// EqMasterWidget::step() on a mapped mixer change
+	check("eq init track refresh kept by a label poll", updateTrackLabelRequest == 2);
+	updateTrackLabelRequest = 0;
+	raiseTrackLabelRequest(&updateTrackLabelRequest, 1);
+	check("eq label poll requests a label read", updateTrackLabelRequest == 1);
+	
+	// mixer message bus: a MixMaster sends "id + 1" and Module::id is -1 in its constructor, so id 0 must not touch the free slots
+	MixerMessageBus *bus = new MixerMessageBus;
+	char masterLabel[7] = "MASTER";
+	char trackLabels[(16 + 4) * 4];
+	char auxLabels[4 * 4];
+	int8_t colors[1 + 16 + 4 + 4] = {0};
+	memset(trackLabels, 'T', sizeof(trackLabels));
+	memset(auxLabels, 'A', sizeof(auxLabels));
+	bus->send(0, masterLabel, trackLabels, auxLabels, colors, colors);
+	bus->send(-1, masterLabel, trackLabels, auxLabels, colors, colors);
+	MixerMessage message;
+	message.id = 0;
+	bool received = bus->receive(&message);
+	MessageBase members[4];
+	check("bus ignores sends with id <= 0", received && message.name[0] == 0 && bus->surveyValues(members, 4) == 0);
+	bus->send(5, masterLabel, trackLabels, auxLabels, colors, colors);
+	uint32_t generation = bus->getGeneration(5);
+	bus->send(5, masterLabel, trackLabels, auxLabels, colors, colors);
+	message.id = 5;
+	received = bus->receive(&message);
+	check("bus delivers a registered sender's labels", received && message.id == 5 && memcmp(message.name, masterLabel, 6) == 0 && message.trkGrpAuxLabels[0] == 'T');
+	check("bus keeps generation of unchanged content", generation != 0 && bus->getGeneration(5) == generation && bus->surveyValues(members, 4) == 1);
+	bus->deregisterMember(5);
+	check("bus frees the slot of a deregistered sender", bus->getGeneration(5) == 0 && bus->surveyValues(members, 4) == 0);
+	delete bus;
+	
+	// a track that gets its cable back between two input scans (so still in the active tracks) is heard right away,
+	//   not only from the next eco sample that sets its simd lane
+	typedef BenchMixMaster<16, 4> MM;
+	MM *mm = new MM;
+	const Module::ProcessArgs args{benchEngine.getSampleRate(), benchEngine.getSampleTime()};
+	setupScenario<16, 4>(mm, scenarios[0]);// eco on
+	mm->refresh.refreshCounter = 1;
+	mm->inputs[MM::TRACK_SIGNAL_INPUTS + 0].channels = 0;
+	for (int s = 0; s < 2; s++) {// refreshCounter 1 and 2
+		writeTrackInputs<16, 4>(mm, s);
+		mm->process(args);
+	}
+	bool unused = !mm->tracks[0].oldInUse;
+	mm->inputs[MM::TRACK_SIGNAL_INPUTS + 0].channels = 1;
+	writeTrackInputs<16, 4>(mm, 2);
+	mm->process(args);// refreshCounter 3, not an eco sample for the tracks
+	check("reconnected track heard before an eco sample", unused && mm->trackTaps[16 * 4 + 0] != 0.0f);
+	delete mm;
+	
+	printf("\n");
+}
+
+
+int main(int argc, char **argv) {
+	int numSamples = (argc > 1 ? atoi(argv[1]) : 1 << 20);
+	int numRuns = (argc > 2 ? atoi(argv[2]) : 3);
+
+	for (int i = 0; i < numSigSamples; i++) {
+		float ph = (float)i / numSigSamples;
+		sigTable[i] = 4.0f * std::sin(2.0f * float(M_PI) * 11.0f * ph) + (random::uniform() - 0.5f);
+	}
+
+	runChecks();
+	runBench<16, 4>("MixMaster", numSamples, numRuns);
+	runBench<8, 2>("MixMasterJr", numSamples, numRuns);
+	runChainBench(numSamples, numRuns);
+	runEqBench(numSamples, numRuns);
+	runSpectrumBench(numRuns);
+	printf("QuattroBiQuad (24 stereo tracks, 4 bands), %i samples per scenario, best of %i\n", numSamples, numRuns);
+	runBiQuadKernel<false>("direct form I", numSamples, numRuns);
+	runBiQuadKernel<true>("transposed direct form II", numSamples, numRuns);
+	return numFailedChecks == 0 ? 0 : 1;
+}
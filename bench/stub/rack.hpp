@@ -0,0 +1,456 @@
+//***********************************************************************************************
+//Mind Meld Modular: Modules for VCV Rack by Steve Baker and Marc Boulé
+//
+//See ./LICENSE.md for all licenses
+//***********************************************************************************************
+
+// Minimal headless stand-in for the VCV Rack v1 SDK, used only by the DSP benchmark in this folder.
+// Provides just enough of the engine, simd and dsp API (and empty shells for the widget/menu types
+// that the common headers declare) so that the DSP structs in src/ can be compiled and timed
+// without a Rack install. Nothing here is used by the plugin build itself.
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <climits>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <random>
+#include <pmmintrin.h>
+
+
+#define ENUMS(name, count) name, name ## _LAST = name + (count) - 1
+#define GLFW_MOUSE_BUTTON_LEFT 0
+
+
+typedef struct json_t json_t;
+json_t *json_object();
+json_t *json_array();
+json_t *json_integer(long long value);
+json_t *json_real(double value);
+json_t *json_boolean(int value);
+json_t *json_string(const char *value);
+json_t *json_object_get(const json_t *object, const char *key);
+json_t *json_array_get(const json_t *array, size_t index);
+int json_object_set_new(json_t *object, const char *key, json_t *value);
+int json_array_append_new(json_t *array, json_t *value);
+int json_array_insert_new(json_t *array, size_t index, json_t *value);
+long long json_integer_value(const json_t *integer);
+double json_number_value(const json_t *json);
+const char *json_string_value(const json_t *string);
+int json_is_true(const json_t *json);
+
+
+struct NVGcolor {
+	float r, g, b, a;
+};
+struct NVGcontext;
+struct NVGpaint {
+	float xform[6];
+	float extent[2];
+	float radius, feather;
+	NVGcolor innerColor, outerColor;
+	int image;
+};
+inline NVGcolor nvgRGBA(unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+	return NVGcolor{r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f};
+}
+inline NVGcolor nvgRGB(unsigned char r, unsigned char g, unsigned char b) {
+	return nvgRGBA(r, g, b, 255);
+}
+
+
+// pffft (aligned allocation only, no transforms)
+inline void *pffft_aligned_malloc(size_t nb_bytes) {
+	void *p = NULL;
+	return posix_memalign(&p, 64, nb_bytes) == 0 ? p : NULL;
+}
+inline void pffft_aligned_free(void *p) {
+	free(p);
+}
+
+
+namespace rack {
+
+
+namespace random {
+	inline uint32_t u32() {
+		static std::minstd_rand rng(0x4d4d4d);
+		return (uint32_t)rng();
+	}
+	inline float uniform() {
+		return (u32() & 0xFFFFFF) / float(0x1000000);
+	}
+}// namespace random
+
+
+namespace math {
+	inline int clamp(int x, int a, int b) {return std::max(std::min(x, b), a);}
+	inline float clamp(float x, float a, float b) {return std::fmax(std::fmin(x, b), a);}
+	inline float rescale(float x, float xMin, float xMax, float yMin, float yMax) {
+		return yMin + (x - xMin) / (xMax - xMin) * (yMax - yMin);
+	}
+	inline float crossfade(float a, float b, float p) {return a + (b - a) * p;}
+
+	struct Vec {
+		float x = 0.f;
+		float y = 0.f;
+		Vec() {}
+		Vec(float x, float y) : x(x), y(y) {}
+		Vec plus(Vec b) const {return Vec(x + b.x, y + b.y);}
+		Vec minus(Vec b) const {return Vec(x - b.x, y - b.y);}
+		Vec mult(float s) const {return Vec(x * s, y * s);}
+		Vec div(float s) const {return Vec(x / s, y / s);}
+	};
+	struct Rect {
+		Vec pos;
+		Vec size;
+	};
+}// namespace math
+
+
+namespace simd {
+	// SSE subset of Rack's simd::Vector<float, 4>
+	struct float_4 {
+		union {
+			__m128 v;
+			float s[4];
+		};
+
+		float_4() = default;
+		float_4(__m128 v) : v(v) {}
+		float_4(float x) {v = _mm_set1_ps(x);}
+		float_4(float x1, float x2, float x3, float x4) {v = _mm_setr_ps(x1, x2, x3, x4);}
+		static float_4 zero() {return float_4(_mm_setzero_ps());}
+		static float_4 mask() {return float_4(_mm_castsi128_ps(_mm_set1_epi32(-1)));}
+		static float_4 load(const float *x) {return float_4(_mm_loadu_ps(x));}
+		void store(float *x) {_mm_storeu_ps(x, v);}
+		float &operator[](int i) {return s[i];}
+		const float &operator[](int i) const {return s[i];}
+	};
+
+	inline float_4 operator+(float_4 a, float_4 b) {return _mm_add_ps(a.v, b.v);}
+	inline float_4 operator-(float_4 a, float_4 b) {return _mm_sub_ps(a.v, b.v);}
+	inline float_4 operator*(float_4 a, float_4 b) {return _mm_mul_ps(a.v, b.v);}
+	inline float_4 operator/(float_4 a, float_4 b) {return _mm_div_ps(a.v, b.v);}
+	inline float_4 operator-(float_4 a) {return _mm_sub_ps(_mm_setzero_ps(), a.v);}
+	inline float_4 operator+(float_4 a) {return a;}
+	inline float_4 operator==(float_4 a, float_4 b) {return _mm_cmpeq_ps(a.v, b.v);}
+	inline float_4 operator!=(float_4 a, float_4 b) {return _mm_cmpneq_ps(a.v, b.v);}
+	inline float_4 operator<(float_4 a, float_4 b) {return _mm_cmplt_ps(a.v, b.v);}
+	inline float_4 operator<=(float_4 a, float_4 b) {return _mm_cmple_ps(a.v, b.v);}
+	inline float_4 operator>(float_4 a, float_4 b) {return _mm_cmpgt_ps(a.v, b.v);}
+	inline float_4 operator>=(float_4 a, float_4 b) {return _mm_cmpge_ps(a.v, b.v);}
+	inline float_4 operator&(float_4 a, float_4 b) {return _mm_and_ps(a.v, b.v);}
+	inline float_4 operator|(float_4 a, float_4 b) {return _mm_or_ps(a.v, b.v);}
+	inline float_4 operator^(float_4 a, float_4 b) {return _mm_xor_ps(a.v, b.v);}
+	inline float_4 operator~(float_4 a) {return _mm_xor_ps(a.v, float_4::mask().v);}
+	inline float_4 &operator+=(float_4 &a, float_4 b) {return a = a + b;}
+	inline float_4 &operator-=(float_4 &a, float_4 b) {return a = a - b;}
+	inline float_4 &operator*=(float_4 &a, float_4 b) {return a = a * b;}
+	inline float_4 &operator/=(float_4 &a, float_4 b) {return a = a / b;}
+	inline float_4 &operator&=(float_4 &a, float_4 b) {return a = a & b;}
+	inline float_4 &operator|=(float_4 &a, float_4 b) {return a = a | b;}
+
+	inline int movemask(float_4 a) {return _mm_movemask_ps(a.v);}
+	inline float_4 ifelse(float_4 mask, float_4 a, float_4 b) {return (mask & a) | _mm_andnot_ps(mask.v, b.v);}
+	inline float ifelse(bool cond, float a, float b) {return cond ? a : b;}
+	inline float_4 fmax(float_4 a, float_4 b) {return _mm_max_ps(a.v, b.v);}
+	inline float_4 fmin(float_4 a, float_4 b) {return _mm_min_ps(a.v, b.v);}
+	inline float_4 sqrt(float_4 a) {return _mm_sqrt_ps(a.v);}
+	inline float_4 abs(float_4 a) {return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v);}
+	inline float_4 clamp(float_4 x, float_4 a, float_4 b) {return fmin(fmax(x, a), b);}
+	inline float clamp(float x, float a, float b) {return std::fmin(std::fmax(x, a), b);}
+	inline float_4 hypot(float_4 a, float_4 b) {return sqrt(a * a + b * b);}
+	inline float_4 rescale(float_4 x, float_4 xMin, float_4 xMax, float_4 yMin, float_4 yMax) {
+		return yMin + (x - xMin) / (xMax - xMin) * (yMax - yMin);
+	}
+	inline float_4 crossfade(float_4 a, float_4 b, float_4 p) {return a + (b - a) * p;}
+
+	#define MM_STUB_SIMD_UNARY(name) \
+		inline float_4 name(float_4 a) {return float_4(std::name(a.s[0]), std::name(a.s[1]), std::name(a.s[2]), std::name(a.s[3]));}
+	MM_STUB_SIMD_UNARY(exp)
+	MM_STUB_SIMD_UNARY(log)
+	MM_STUB_SIMD_UNARY(log2)
+	MM_STUB_SIMD_UNARY(log10)
+	MM_STUB_SIMD_UNARY(sin)
+	MM_STUB_SIMD_UNARY(cos)
+	MM_STUB_SIMD_UNARY(tan)
+	MM_STUB_SIMD_UNARY(floor)
+	MM_STUB_SIMD_UNARY(ceil)
+	MM_STUB_SIMD_UNARY(round)
+	#undef MM_STUB_SIMD_UNARY
+	inline float_4 pow(float_4 a, float_4 b) {return exp(b * log(a));}
+	inline float_4 pow(float a, float_4 b) {return exp(b * std::log(a));}
+	inline float_4 pow(float_4 a, float b) {return exp(b * log(a));}
+	inline float pow(float a, float b) {return std::pow(a, b);}
+}// namespace simd
+
+
+namespace dsp {
+	struct SchmittTrigger {
+		bool state = true;
+		void reset() {state = true;}
+	};
+
+	template <typename T>
+	inline T blackmanHarris(T p) {
+		return 0.35875f - 0.48829f * std::cos(2 * float(M_PI) * p) + 0.14128f * std::cos(4 * float(M_PI) * p) - 0.01168f * std::cos(6 * float(M_PI) * p);
+	}
+}// namespace dsp
+
+
+namespace plugin {
+	struct Plugin {};
+	struct Model {};
+}// namespace plugin
+
+
+namespace engine {
+	static const int PORT_MAX_CHANNELS = 16;
+
+	struct Param {
+		float value = 0.f;
+		float getValue() {return value;}
+		void setValue(float value) {this->value = value;}
+	};
+
+	struct Light {
+		float value = 0.f;
+		void setBrightness(float brightness) {value = brightness;}
+		float getBrightness() {return value;}
+	};
+
+	struct Port {
+		union {
+			float voltages[PORT_MAX_CHANNELS] = {};
+			float value;
+		};
+		uint8_t channels = 0;
+
+		void setVoltage(float voltage, int channel = 0) {voltages[channel] = voltage;}
+		float getVoltage(int channel = 0) {return voltages[channel];}
+		float getPolyVoltage(int channel) {return isMonophonic() ? getVoltage(0) : getVoltage(channel);}
+		float getNormalVoltage(float normalVoltage, int channel = 0) {return isConnected() ? getVoltage(channel) : normalVoltage;}
+		float *getVoltages(int firstChannel = 0) {return &voltages[firstChannel];}
+		void readVoltages(float *v) {std::memcpy(v, voltages, channels * sizeof(float));}
+		void writeVoltages(const float *v) {std::memcpy(voltages, v, channels * sizeof(float));}
+		void clearVoltages() {std::memset(voltages, 0, sizeof(voltages));}
+		float getVoltageSum() {
+			float sum = 0.f;
+			for (int c = 0; c < channels; c++) {
+				sum += voltages[c];
+			}
+			return sum;
+		}
+		template <typename T>
+		T getVoltageSimd(int firstChannel) {return T::load(&voltages[firstChannel]);}
+		template <typename T>
+		void setVoltageSimd(T voltage, int firstChannel) {voltage.store(&voltages[firstChannel]);}
+		bool isConnected() {return channels > 0;}
+		bool isMonophonic() {return channels == 1;}
+		bool isPolyphonic() {return channels > 1;}
+		int getChannels() {return channels;}
+		void setChannels(int channels) {
+			if (this->channels == 0) {
+				return;
+			}
+			for (int c = channels; c < this->channels; c++) {
+				voltages[c] = 0.f;
+			}
+			if (channels == 0) {
+				channels = 1;
+			}
+			this->channels = channels;
+		}
+	};
+	struct Input : Port {};
+	struct Output : Port {};
+
+	struct Engine {
+		float sampleRate = 44100.0f;
+		float getSampleRate() {return sampleRate;}
+		float getSampleTime() {return 1.0f / sampleRate;}
+	};
+
+	struct Module {
+		int id = -1;
+		plugin::Model *model = NULL;
+		std::vector<Param> params;
+		std::vector<Input> inputs;
+		std::vector<Output> outputs;
+		std::vector<Light> lights;
+		struct Expander {
+			int moduleId = -1;
+			Module *module = NULL;
+			void *producerMessage = NULL;
+			void *consumerMessage = NULL;
+			bool messageFlipRequested = false;
+		};
+		Expander leftExpander;
+		Expander rightExpander;
+		struct ProcessArgs {
+			float sampleRate;
+			float sampleTime;
+		};
+
+		virtual ~Module() {}
+		void config(int numParams, int numInputs, int numOutputs, int numLights = 0) {
+			params.resize(numParams);
+			inputs.resize(numInputs);
+			outputs.resize(numOutputs);
+			lights.resize(numLights);
+		}
+		virtual void process(const ProcessArgs &args) {}
+		virtual void onReset() {}
+		virtual void onRandomize() {}
+		virtual void onSampleRateChange() {}
+		virtual json_t *dataToJson() {return NULL;}
+		virtual void dataFromJson(json_t *rootJ) {}
+	};
+}// namespace engine
+
+
+namespace asset {
+	inline std::string plugin(plugin::Plugin *plugin, const std::string &filename) {return filename;}
+}// namespace asset
+
+
+namespace event {
+	struct Action {};
+	struct Change {};
+	struct DragStart {int button = 0;};
+	struct DragEnd {int button = 0;};
+}// namespace event
+
+
+// Widget shells: declared so the common headers compile, never instantiated by the benchmark
+
+struct Svg {};
+
+namespace widget {
+	struct Widget {
+		math::Rect box;
+		bool visible = true;
+		std::list<Widget*> children;
+		struct DrawArgs {
+			NVGcontext *vg = NULL;
+		};
+		virtual ~Widget() {}
+		void addChild(Widget *child) {children.push_back(child);}
+		virtual void step() {}
+		virtual void draw(const DrawArgs &args) {}
+		virtual void onChange(const event::Change &e) {}
+		virtual void onDragStart(const event::DragStart &e) {}
+		virtual void onDragEnd(const event::DragEnd &e) {}
+		virtual void onAction(const event::Action &e) {}
+	};
+	struct OpaqueWidget : Widget {};
+	struct TransparentWidget : Widget {};
+	struct FramebufferWidget : Widget {
+		bool dirty = true;
+	};
+	struct SvgWidget : Widget {
+		std::shared_ptr<Svg> svg;
+		void setSvg(std::shared_ptr<Svg> svg) {this->svg = svg;}
+	};
+}// namespace widget
+
+namespace ui {
+	struct Menu : widget::OpaqueWidget {};
+	struct MenuEntry : widget::OpaqueWidget {};
+	struct MenuItem : MenuEntry {
+		std::string text;
+		std::string rightText;
+		virtual Menu *createChildMenu() {return NULL;}
+	};
+	struct MenuLabel : MenuEntry {
+		std::string text;
+	};
+}// namespace ui
+
+namespace app {
+	struct CircularShadow : widget::TransparentWidget {
+		float blurRadius = 0.f;
+		float opacity = 0.15f;
+	};
+	struct ParamWidget : widget::OpaqueWidget {
+		virtual void randomize() {}
+	};
+	struct SvgSwitch : ParamWidget {
+		bool momentary = false;
+		CircularShadow *shadow = new CircularShadow;
+		void addFrame(std::shared_ptr<Svg> svg) {}
+	};
+	struct SvgKnob : ParamWidget {
+		float minAngle = -M_PI;
+		float maxAngle = M_PI;
+		CircularShadow *shadow = new CircularShadow;
+		void setSvg(std::shared_ptr<Svg> svg) {}
+	};
+	struct SvgSlider : ParamWidget {
+		widget::SvgWidget *background = new widget::SvgWidget;
+		widget::SvgWidget *handle = new widget::SvgWidget;
+		math::Vec minHandlePos, maxHandlePos;
+		void setBackgroundSvg(std::shared_ptr<Svg> svg) {}
+		void setHandleSvg(std::shared_ptr<Svg> svg) {}
+	};
+	struct SvgPort : widget::OpaqueWidget {
+		CircularShadow *shadow = new CircularShadow;
+		void setSvg(std::shared_ptr<Svg> svg) {}
+	};
+	struct LightWidget : widget::TransparentWidget {};
+	struct ModuleLightWidget : LightWidget {
+		void addBaseColor(NVGcolor color) {}
+	};
+	struct GrayModuleLightWidget : ModuleLightWidget {};
+	struct PanelBorder : widget::TransparentWidget {};
+
+	struct Window {
+		std::shared_ptr<Svg> loadSvg(const std::string &filename) {return std::make_shared<Svg>();}
+	};
+	struct Context {
+		engine::Engine *engine;
+		Window *window;
+	};
+	Context *contextGet();
+}// namespace app
+
+#define APP rack::app::contextGet()
+
+static const NVGcolor SCHEME_WHITE = nvgRGB(0xff, 0xff, 0xff);
+static const NVGcolor SCHEME_BLUE = nvgRGB(0x29, 0xb2, 0xef);
+static const float MM_PER_IN = 25.4f;
+static const float SVG_DPI = 75.f;
+inline float mm2px(float mm) {return mm * (SVG_DPI / MM_PER_IN);}
+inline math::Vec mm2px(math::Vec mm) {return mm.mult(SVG_DPI / MM_PER_IN);}
+
+inline std::string CHECKMARK(bool checked) {return checked ? "✔" : "";}
+
+template <class TMenuItem = ui::MenuItem>
+TMenuItem *createMenuItem(std::string text, std::string rightText = "") {
+	TMenuItem *o = new TMenuItem;
+	o->text = text;
+	o->rightText = rightText;
+	return o;
+}
+
+
+using namespace math;
+using namespace widget;
+using namespace ui;
+using namespace app;
+using namespace engine;
+using plugin::Plugin;
+using plugin::Model;
+
+
+}// namespace rack
@@ -755,6 +755,13 @@ struct AuxExpanderWidget : ModuleWidget {
         setPanel(APP->window->loadSvg(asset::plugin(pluginInstance, "res/dark/auxspander.svg")));
 		panelBorder = findBorder(panel);
 
+		// VU meter bridge, draws the aux return VUs below in a few batched fills
+		VuMeterBridge *vuBridge = NULL;
+		if (module) {
+			addChild(vuBridge = createWidget<VuMeterBridge>(Vec(0, 0)));
+			vuBridge->box.size = box.size;
+		}
+
 
 		// Left side (globals)
 		for (int i = 0; i < 4; i++) {
@@ -812,6 +819,7 @@ struct AuxExpanderWidget : ModuleWidget {
 				newVU->colorThemeGlobal = &(module->colorAndCloak.cc4[vuColorGlobal]);
 				newVU->colorThemeLocal = &(module->vuColorThemeLocal.cc4[i]);
 				addChild(newVU);
+				vuBridge->addMeter(newVU);
 				// Fade pointers
 				CvAndFadePointerAuxRet *newFP = createWidgetCentered<CvAndFadePointerAuxRet>(mm2px(Vec(6.35 - 2.95 + 12.7 * i, 87.2)));
 				newFP->srcParam = &(module->params[TAuxExpander::GLOBAL_AUXRETURN_PARAMS + i]);
@@ -1108,6 +1116,13 @@ struct AuxExpanderJrWidget : ModuleWidget {
         setPanel(APP->window->loadSvg(asset::plugin(pluginInstance, "res/dark/auxspander-jr.svg")));
 		panelBorder = findBorder(panel);
 
+		// VU meter bridge, draws the aux return VUs below in a few batched fills
+		VuMeterBridge *vuBridge = NULL;
+		if (module) {
+			addChild(vuBridge = createWidget<VuMeterBridge>(Vec(0, 0)));
+			vuBridge->box.size = box.size;
+		}
+
 
 		// Left side (globals)
 		for (int i = 0; i < 4; i++) {
@@ -1165,6 +1180,7 @@ struct AuxExpanderJrWidget : ModuleWidget {
 				newVU->colorThemeGlobal = &(module->colorAndCloak.cc4[vuColorGlobal]);
 				newVU->colorThemeLocal = &(module->vuColorThemeLocal.cc4[i]);
 				addChild(newVU);
+				vuBridge->addMeter(newVU);
 				// Fade pointers
 				CvAndFadePointerAuxRet *newFP = createWidgetCentered<CvAndFadePointerAuxRet>(mm2px(Vec(6.35 - 2.95 + 12.7 * i, 87.2)));
 				newFP->srcParam = &(module->params[TAuxExpander::GLOBAL_AUXRETURN_PARAMS + i]);
@@ -30,8 +30,17 @@ struct EqExpander : Module {
 	};
 	
 
+	// Need to save, no reset
+	// none
+	
+	// Need to save, with reset
+	bool audioRateCvs;// send the band cvs of all 24 tracks every sample, instead of 4 tracks per sample
+	
+	// No need to save, with reset
 	int refreshCounter6;
 	int refreshCounter25;
+	
+	// No need to save, no reset
 	bool motherPresentLeft = false;
 	bool motherPresentRight = false;
 	
@@ -44,6 +53,7 @@ struct EqExpander : Module {
   
   
 	void onReset() override {
+		audioRateCvs = false;
 		resetNonJson();
 	}
 	void resetNonJson() {
@@ -58,12 +68,19 @@ struct EqExpander : Module {
 	
 	json_t *dataToJson() override {
 		json_t *rootJ = json_object();
-				
+		
+		// audioRateCvs
+		json_object_set_new(rootJ, "audioRateCvs", json_boolean(audioRateCvs));
+		
 		return rootJ;
 	}
 
 
 	void dataFromJson(json_t *rootJ) override {
+		// audioRateCvs
+		json_t *audioRateCvsJ = json_object_get(rootJ, "audioRateCvs");
+		if (audioRateCvsJ)
+			audioRateCvs = json_is_true(audioRateCvsJ);
 
 		resetNonJson();
 	}
@@ -87,16 +104,31 @@ struct EqExpander : Module {
 			
 			messagesToMother->trackCvsIndex6 = refreshCounter6;
 			messagesToMother->trackEnableIndex = refreshCounter25;
+			messagesToMother->trackCvsAll = audioRateCvs;
 			
 			// track band values
-			int cvConnectedSubset = 0;
-			for (int i = 0; i < 4; i++) {
-				if (inputs[TRACK_CV_INPUTS + (refreshCounter6 << 2) + i].isConnected()) {
-					cvConnectedSubset |= (1 << i);
-					memcpy(&(messagesToMother->trackCvs[16 * i]), inputs[TRACK_CV_INPUTS + (refreshCounter6 << 2) + i].getVoltages(), 16 * 4);
+			if (audioRateCvs) {
+				// all tracks, each refreshed at fs
+				int cvConnectedAll = 0;
+				for (int t = 0; t < 24; t++) {
+					if (inputs[TRACK_CV_INPUTS + t].isConnected()) {
+						cvConnectedAll |= (1 << t);
+						memcpy(&(messagesToMother->trackCvs[16 * t]), inputs[TRACK_CV_INPUTS + t].getVoltages(), 16 * 4);
+					}
+				}
+				messagesToMother->trackCvsConnected = cvConnectedAll;
+			}
+			else {
+				// 4 tracks, each refreshed at fs / 6
+				int cvConnectedSubset = 0;
+				for (int i = 0; i < 4; i++) {
+					if (inputs[TRACK_CV_INPUTS + (refreshCounter6 << 2) + i].isConnected()) {
+						cvConnectedSubset |= (1 << i);
+						memcpy(&(messagesToMother->trackCvs[16 * i]), inputs[TRACK_CV_INPUTS + (refreshCounter6 << 2) + i].getVoltages(), 16 * 4);
+					}
 				}
+				messagesToMother->trackCvsConnected = cvConnectedSubset;
 			}
-			messagesToMother->trackCvsConnected = cvConnectedSubset;
 			
 			// track enables
 			messagesToMother->trackEnable = refreshCounter25 < 16 ? 
@@ -131,6 +163,24 @@ struct EqExpander : Module {
 struct EqExpanderWidget : ModuleWidget {
 	PanelBorder* panelBorder;
 
+	struct AudioRateCvsItem : MenuItem {
+		EqExpander *module;
+		void onAction(const event::Action &e) override {
+			module->audioRateCvs = !module->audioRateCvs;
+		}
+	};
+
+	void appendContextMenu(Menu *menu) override {
+		EqExpander *module = (EqExpander*)(this->module);
+		assert(module);
+
+		menu->addChild(new MenuSeparator());
+		
+		AudioRateCvsItem *audioRateItem = createMenuItem<AudioRateCvsItem>("Audio-rate band CVs", CHECKMARK(module->audioRateCvs));
+		audioRateItem->module = module;
+		menu->addChild(audioRateItem);
+	}
+
 	
 	EqExpanderWidget(EqExpander *module) {
 		setModule(module);
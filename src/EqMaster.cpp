@@ -48,33 +48,44 @@ struct EqMaster : Module {
 	PackedBytes4 miscSettings;// cc4[0] is ShowBandCurvesEQ, cc4[1] is fft type (0 = off, 1 = pre, 2 = post, 3 = freeze), cc4[2] is momentaryCvButtons (1 = yes (original rising edge only version), 0 = level sensitive (emulated with rising and falling detection)), cc4[3] is detailsShow
 	PackedBytes4 miscSettings2;// cc4[0] is band label colours, cc4[1] is decay rate (0 = slow, 1 = med, 2 = fast), cc[2] is hide eq curves when bypassed, cc[3] is unused
 	PackedBytes4 showFreqAsNotes;
+	PackedBytes4 miscSettings3;// cc4[0] is log2 of the fft size (FFT_LOG2_N_MIN to FFT_LOG2_N_MAX), cc4[1] is fft overlap (0 = 50%, 1 = 75%), cc[2] is multi-track spectrum (0 = off, 1 = active tracks, 2 = chosen tracks), cc[3] is analyser ballistics (SPEC_BALL_PEAK, SPEC_BALL_RMS, SPEC_BALL_EXP)
+	uint32_t multiSpecTracks;// chosen tracks for the multi-track spectrum, one bit per track
 	
 	
 	// No need to save, with reset
 	int updateTrackLabelRequest;// 0 when nothing to do, 1 for read names in widget, 2 for same as 1 but force param refreshing
 	VuMeterAllDual trackVu;
-	int fftWriteHead;
-	int page;
 	uint32_t cvConnected;
 	int drawBufSize;
 
 	// No need to save, no reset
 	RefreshCounter refresh;
+	FftInputRing fftInputs;// spectrum input samples, from the audio thread to the worker
+	// worker only (once the worker is started):
 	PFFFT_Setup* ffts;// https://bitbucket.org/jpommier/pffft/src/default/test_pffft.c
-	float* fftIn[3];
-	float* fftOut;
+	int fftN;// current fft size, see miscSettings3
+	float* fftIn;//[fftN] windowed frame
+	float* fftOut;//[fftN]
+	float *windowFunc;//[fftN / 2] precomputed window function for FFT; function is symetrical, so only first half of window is actually stored here
+	SpectrumBinLut specBinLut;// fft bin ranges of the pixel columns, for the current fftN and sample rate
 	TriggerRiseFall trackEnableCvTriggers[24+1];
 	TriggerRiseFall trackBandCvTriggers[24][4];
 	bool expPresentLeft = false;
 	bool expPresentRight = false;
-	std::mutex m;
-	float *drawBuf;//[FFT_N] store log magnitude only in first half, log freq in second half (normally this is compacted freq bins, so not all array used)
-	float *drawBufLin;//[FFT_N_2] store lin magnitude, used for calculating decay (normally this is compacted freq bins, so not all array used)
-	float *windowFunc;//[FFT_N_2] precomputed window function for FFT; function is symetrical, so only first half of window is actually stored here
-	bool requestStop = false;
-	bool requestWork = false;
-	int requestPage = 0;
-	std::condition_variable cv;// https://thispointer.com//c11-multithreading-part-7-condition-variables-explained/
+	float *drawBuf;//[DRAW_BUF_N_2 * 2] store log magnitude only in first half, log freq in second half (normally this is compacted freq bins, so not all array used)
+	float *drawBufLin;//[DRAW_BUF_N_2] smoothing state of the magnitudes, power or log2 of power depending on the ballistics (normally this is compacted freq bins, so not all array used)
+	int8_t drawBufLinBallistics;// worker only, ballistics of drawBufLin, -1 to restart from the next frame
+	FftQuadCapture fftQuadCapture;// multi-track spectrum inputs, four tracks at a time, from the audio thread to the worker
+	float *trackSpecs;//[24 * DRAW_BUF_N_2] multi-track spectrum, log magnitude of the compacted freq bins of each track (same scaling as drawBuf)
+	float *trackSpecsX;//[DRAW_BUF_N_2] log freq of the compacted freq bins of trackSpecs, same for all tracks
+	int trackSpecsSize[24];// number of compacted freq bins in each track's trackSpecs, -1 when no data to draw
+	int multiSpecLastQuad;// worker only
+	static constexpr float specVertScaling = 1.1f;
+	static constexpr float specVertOffset = 10.0f;
+	static constexpr float specLog2Scaling = specVertScaling * 20.0f * 0.30103f;// 20 * log10(x) = 20 * log10(2) * log2(x)
+	std::atomic<bool> requestStop;
+	std::mutex workerMutex;
+	std::condition_variable workerCv;// wakes the worker parked while the analyser is off, see wakeWorker()
 	std::thread worker;// http://www.cplusplus.com/reference/thread/thread/thread/
 	
 	int getSelectedTrack() {
@@ -97,19 +108,42 @@ struct EqMaster : Module {
 		}
 	}
 	
-	float *allocateAndCalcWindowFunc() {
-		float *buf = (float*)pffft_aligned_malloc(FFT_N_2 * 4);
-		for (unsigned int i = 0; i < (FFT_N_2 / 4); i++) {
+	float *allocateAndCalcWindowFunc(int n) {
+		float *buf = (float*)pffft_aligned_malloc((n >> 1) * 4);
+		for (int i = 0; i < (n >> 3); i++) {
 			simd::float_4 p = {(float)(i * 4 + 0), (float)(i * 4 + 1), (float)(i * 4 + 2), (float)(i * 4 + 3)};
-			p /= (float)(FFT_N - 1);
+			p /= (float)(n - 1);
 			p = dsp::blackmanHarris<simd::float_4>(p);
 			p.store(&(buf[i * 4]));		
 		}	
 		return buf;
 	}
 	
+	void allocateFft(int n) {
+		fftN = n;
+		ffts = pffft_new_setup(fftN, PFFFT_REAL);
+		fftIn = (float*)pffft_aligned_malloc(fftN * 4);
+		fftOut = (float*)pffft_aligned_malloc(fftN * 4);
+		windowFunc = allocateAndCalcWindowFunc(fftN);
+	}
+	
+	void freeFft() {
+		pffft_destroy_setup(ffts);
+		pffft_aligned_free(fftIn);
+		pffft_aligned_free(fftOut);
+		pffft_aligned_free(windowFunc);
+	}
+	
+	int getFftN() {
+		return 1 << clamp((int)miscSettings3.cc4[0], FFT_LOG2_N_MIN, FFT_LOG2_N_MAX);
+	}
+	
+	int getFftHop() {
+		return fftN >> (miscSettings3.cc4[1] == 0 ? 1 : 2);
+	}
+	
 		
-	EqMaster() : worker(&EqMaster::worker_thread, this) {
+	EqMaster() : requestStop(false) {
 		config(NUM_EQ_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
 		
 		rightExpander.producerMessage = &expMessages[0];
@@ -133,37 +167,43 @@ struct EqMaster : Module {
 		configParam(HIGH_PEAK_PARAM, 0.0f, 1.0f, DEFAULT_highPeak ? 1.0f : 0.0f, "HF peak/shelf");
 		configParam(GLOBAL_BYPASS_PARAM, 0.0f, 1.0f, 0.0f, "Global bypass");
 		
+		for (int t = 0; t < 24; t++) {
+			trackEqs[t].setCoeffUpdateInterval(4);// eq coefficients recalculated every 4 samples while slewing, ramped in between
+		}
 		onReset();
 		
-		ffts = pffft_new_setup(FFT_N, PFFFT_REAL);
-		fftIn[0] = (float*)pffft_aligned_malloc(FFT_N * 4);
-		fftIn[1] = (float*)pffft_aligned_malloc(FFT_N * 4);
-		fftIn[2] = (float*)pffft_aligned_malloc(FFT_N * 4);
-		fftOut = (float*)pffft_aligned_malloc(FFT_N * 4);
-		drawBuf = (float*)pffft_aligned_malloc(FFT_N * 4);
-		drawBufLin = (float*)pffft_aligned_malloc(FFT_N_2 * 4);
-		for (int i = 0; i < FFT_N_2; i++) {
+		allocateFft(getFftN());
+		fftInputs.restart(fftN);
+		drawBuf = (float*)pffft_aligned_malloc(DRAW_BUF_N_2 * 2 * 4);
+		drawBufLin = (float*)pffft_aligned_malloc(DRAW_BUF_N_2 * 4);
+		for (int i = 0; i < DRAW_BUF_N_2; i++) {
 			drawBuf[i] = -1.0f;
 			drawBufLin[i] = 0.0f;
 		}
-		windowFunc = allocateAndCalcWindowFunc();
+		drawBufLinBallistics = -1;
+		trackSpecs = (float*)pffft_aligned_malloc(24 * DRAW_BUF_N_2 * 4);
+		trackSpecsX = (float*)pffft_aligned_malloc(DRAW_BUF_N_2 * 4);
+		for (int t = 0; t < 24; t++) {
+			trackSpecsSize[t] = -1;
+		}
+		multiSpecLastQuad = 24 / 4 - 1;
+		
+		worker = std::thread(&EqMaster::worker_thread, this);// last, since the worker uses all of the above
 	}
   
 	~EqMaster() {
-		std::unique_lock<std::mutex> lk(m);
-		requestStop = true;
-		lk.unlock();
-		cv.notify_one();
+		{
+			std::lock_guard<std::mutex> lock(workerMutex);
+			requestStop = true;
+		}
+		workerCv.notify_one();
 		worker.join();
 		
-		pffft_destroy_setup(ffts);
-		pffft_aligned_free(fftIn[0]);
-		pffft_aligned_free(fftIn[1]);
-		pffft_aligned_free(fftIn[2]);
-		pffft_aligned_free(fftOut);
+		freeFft();
 		pffft_aligned_free(drawBuf);
 		pffft_aligned_free(drawBufLin);
-		pffft_aligned_free(windowFunc);
+		pffft_aligned_free(trackSpecs);
+		pffft_aligned_free(trackSpecsX);
 	}
   
 	void onReset() override {
@@ -180,14 +220,17 @@ struct EqMaster : Module {
 		miscSettings2.cc4[1] = 2;// decay rate fast
 		miscSettings2.cc4[2] = 0;// hide eq curves when bypassed
 		miscSettings2.cc4[3] = 0;// unused
+		miscSettings3.cc4[0] = FFT_LOG2_N_DEFAULT;// fft size
+		miscSettings3.cc4[1] = 0;// fft overlap 50%
+		miscSettings3.cc4[2] = 0;// multi-track spectrum off
+		miscSettings3.cc4[3] = SPEC_BALL_PEAK;// analyser ballistics
+		multiSpecTracks = 0xFFFFFF;
 		showFreqAsNotes.cc1 = 0;
 		resetNonJson();
 	}
 	void resetNonJson() {
 		updateTrackLabelRequest = 1;
 		trackVu.reset();
-		fftWriteHead = 0;
-		page = 0;
 		cvConnected = 0;
 		drawBufSize = -1;// no data to draw yet
 	}
@@ -226,6 +269,12 @@ struct EqMaster : Module {
 		// miscSettings2
 		json_object_set_new(rootJ, "miscSettings2", json_integer(miscSettings2.cc1));
 				
+		// miscSettings3
+		json_object_set_new(rootJ, "miscSettings3", json_integer(miscSettings3.cc1));
+				
+		// multiSpecTracks
+		json_object_set_new(rootJ, "multiSpecTracks", json_integer(multiSpecTracks));
+				
 		// showFreqAsNotes
 		json_object_set_new(rootJ, "showFreqAsNotes", json_integer(showFreqAsNotes.cc1));
 				
@@ -370,6 +419,16 @@ struct EqMaster : Module {
 		if (miscSettings2J)
 			miscSettings2.cc1 = json_integer_value(miscSettings2J);
 
+		// miscSettings3
+		json_t *miscSettings3J = json_object_get(rootJ, "miscSettings3");
+		if (miscSettings3J)
+			miscSettings3.cc1 = json_integer_value(miscSettings3J);
+
+		// multiSpecTracks
+		json_t *multiSpecTracksJ = json_object_get(rootJ, "multiSpecTracks");
+		if (multiSpecTracksJ)
+			multiSpecTracks = json_integer_value(multiSpecTracksJ);
+
 		// showFreqAsNotes
 		json_t *showFreqAsNotesJ = json_object_get(rootJ, "showFreqAsNotes");
 		if (showFreqAsNotesJ)
@@ -516,52 +575,149 @@ struct EqMaster : Module {
 	
 	
 	
+	int calcCompactedSpectrum(float* fftData, float* compactedX) {
+		// fftData[fftN]: ordered fft output, replaced by the squared magnitudes of the compacted bins, one per pixel column
+		// compactedX[DRAW_BUF_N_2]: gets the pixel x of each compacted bin
+		// returns the number of compacted bins
+		specBinLut.update(fftN, trackEqs[0].getSampleRate());
+		int compactedSize = specBinLut.compact(fftData);
+		memcpy(compactedX, specBinLut.getX(), compactedSize * 4);
+		return compactedSize;
+	}
+	
+	
+	uint32_t getMultiSpecTracks() {// tracks to analyse in the multi-track spectrum, 0 when off
+		if (miscSettings3.cc4[2] == 1) {// active tracks
+			uint32_t tracks = 0;
+			for (int t = 0; t < 24; t++) {
+				if (trackEqs[t].getTrackActive()) {
+					tracks |= (1 << t);
+				}
+			}
+			return tracks;
+		}
+		if (miscSettings3.cc4[2] == 2) {// chosen tracks
+			return multiSpecTracks & 0xFFFFFF;
+		}
+		return 0;
+	}
+	
+	
+	bool processMultiSpec() {
+		// spectra of the tracks chosen for the multi-track spectrum, four tracks per capture (see FftQuadCapture) and one capture at a time, 
+		//   so the fft load does not depend on the number of tracks, only the update rate of each track does; returns true when work was done
+		//   (when frozen, the spectra are held and no captures are requested, as for the main spectrum)
+		uint32_t tracks = getMultiSpecTracks();
+		bool frozen = (miscSettings.cc4[1] & SPEC_MASK_FREEZE) != 0;
+		for (int t = 0; t < 24; t++) {
+			if ((tracks & (1 << t)) == 0) {
+				trackSpecsSize[t] = -1;
+			}
+		}
+		
+		int captureState = fftQuadCapture.getState();
+		if (captureState == FftQuadCapture::REQUESTED) {
+			return false;
+		}
+		bool worked = false;
+		if (captureState == FftQuadCapture::DONE) {
+			int trkQuad = fftQuadCapture.getQuad();
+			if (!frozen) {// a capture that ends after the freeze is dropped
+				if (fftQuadCapture.isValid() && fftQuadCapture.getN() == fftN) {
+					// the four tracks back to back, with the same fft setup
+					simd::float_4* capture = fftQuadCapture.getBuf();
+					int fftN_2 = fftN >> 1;
+					for (int k = 0; k < 4; k++) {
+						int t = (trkQuad << 2) + k;
+						if ((tracks & (1 << t)) == 0) {
+							continue;
+						}
+						for (int x = 0; x < fftN_2; x++) {
+							fftIn[x] = capture[x][k] * windowFunc[x];
+						}
+						for (int x = fftN_2; x < fftN; x++) {
+							fftIn[x] = capture[x][k] * windowFunc[(fftN - 1) - x];
+						}
+						pffft_transform_ordered(ffts, fftIn, fftOut, NULL, PFFFT_FORWARD);
+						int compactedSize = calcCompactedSpectrum(fftOut, trackSpecsX);
+						float* trackSpec = &trackSpecs[t * DRAW_BUF_N_2];
+						for (int x = 0; x < compactedSize; x += 4) {
+							simd::float_4 vecp = simd::float_4::load(&fftOut[x]);
+							vecp = simd::fmax(log2Fast(vecp) * specLog2Scaling + specVertOffset, -1.0f);
+							vecp.store(&trackSpec[x]);					
+						}
+						trackSpecsSize[t] = compactedSize;
+					}
+				}
+				else {
+					for (int k = 0; k < 4; k++) {
+						trackSpecsSize[(trkQuad << 2) + k] = -1;
+					}
+				}
+			}
+			fftQuadCapture.release();
+			worked = true;
+		}
+		
+		// request the next quad with chosen tracks, round robin
+		if (tracks != 0 && !frozen) {
+			int nextQuad = multiSpecLastQuad;
+			do {
+				nextQuad = (nextQuad + 1) % (24 / 4);
+			} while (((tracks >> (nextQuad << 2)) & 0xF) == 0);
+			multiSpecLastQuad = nextQuad;
+			fftQuadCapture.request(nextQuad, fftN);
+		}
+		return worked;
+	}
+	
+	
+	void wakeWorker() {// not from the audio thread
+		{
+			std::lock_guard<std::mutex> lock(workerMutex);// so that a worker between its check and its wait is not missed
+		}
+		workerCv.notify_one();
+	}
+	
+	
 	void worker_thread() {
-		static const float vertScaling = 1.1f;
-		static const float vertOffset = 10.0f;
-		while (true) {
-			std::unique_lock<std::mutex> lk(m);
-			while (!requestWork && !requestStop) {
-				cv.wait(lk);
+		while (!requestStop) {
+			// park while the analyser is off (the widget calls wakeWorker() when it is turned on, 
+			//   the timeout covers the cases where nobody does, like a module without a widget)
+			if ((miscSettings.cc4[1] & SPEC_MASK_ON) == 0) {
+				std::unique_lock<std::mutex> lock(workerMutex);
+				workerCv.wait_for(lock, std::chrono::milliseconds(250), [this] {
+					return requestStop || (miscSettings.cc4[1] & SPEC_MASK_ON) != 0;
+				});
+				continue;
 			}
-			lk.unlock();
-			if (requestStop) break;
 			
-			// compute fft
-			pffft_transform_ordered(ffts, fftIn[requestPage], fftOut, NULL, PFFFT_FORWARD);
-
-			// calculate magnitude and store in 1st half of array
-			for (int x = 0; x < FFT_N ; x += 2) {	
-				fftOut[x >> 1] = fftOut[x + 0] * fftOut[x + 0] + fftOut[x + 1] * fftOut[x + 1];// sqrt is not needed in magnitude calc since when take log of this, it can be absorbed in scaling multiplier
+			// fft size, reallocated here so that the audio thread never waits on it
+			int newFftN = getFftN();
+			if (newFftN != fftN) {
+				freeFft();
+				allocateFft(newFftN);
+				fftInputs.restart(fftN);
+				drawBufLinBallistics = -1;// compacted bins are not the same freqs anymore
 			}
+			int hop = getFftHop();
 			
-			// calculate pixel scaled log of frequency and store in 2nd half of array
-			for (int x = 0; x < (FFT_N_2) / 4 ; x++) {
-				int xt4 = x << 2;
-				simd::float_4 vecp(xt4 + 0, xt4 + 1, xt4 + 2, xt4 + 3);
-				vecp = (vecp / ((float)(FFT_N - 1))) * trackEqs[0].getSampleRate();// linear freq a this line
-				vecp = simd::round(simd::rescale(simd::log10(vecp), minLogFreq, maxLogFreq, 0.0f, eqCurveWidth));// pixel scaled log freq at this line
-				vecp.store(&fftOut[xt4 + FFT_N_2]);
-			}
+			bool multiSpecWorked = processMultiSpec();
 			
-			// compact frequency bins
-			int i = 1;// index into compacted bins 
-			drawBuf[FFT_N_2] = fftOut[FFT_N_2];
-			for (int x = 1; x < FFT_N_2 ; x++) {// index into non-compacted bins
-				if (drawBuf[i - 1 + FFT_N_2] == fftOut[x + FFT_N_2]) {
-					fftOut[i - 1] = std::fmax(fftOut[i - 1], fftOut[x]);
-				}
-				else {
-					fftOut[i] = fftOut[x];
-					drawBuf[i + FFT_N_2] = fftOut[x + FFT_N_2];
-					i++;
+			if (!fftInputs.readFrame(fftIn, windowFunc, fftN, hop)) {
+				if (!multiSpecWorked) {
+					// poll, since the audio thread does not signal (a hop is at least 256 samples, so more than 1 ms)
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
 				}
+				continue;
 			}
-			int compactedSize = i;
 			
-			// decay
-			static constexpr float noDecay = 1000.0f;
-			float decayFactor = 0.0f;
+			// compute fft
+			pffft_transform_ordered(ffts, fftIn, fftOut, NULL, PFFFT_FORWARD);
+			int compactedSize = calcCompactedSpectrum(fftOut, &drawBuf[DRAW_BUF_N_2]);
+			
+			// decay and log of magnitude, to drawBuf
+			float decayFactor = 0.0f;// freeze
 			if ((miscSettings.cc4[1] & SPEC_MASK_FREEZE) == 0) {
 				if (miscSettings2.cc4[1] == 0) {// slow decay
 					decayFactor = 5.0f;
@@ -573,33 +729,18 @@ struct EqMaster : Module {
 					decayFactor = 20.0f;
 				}
 				else {
-					decayFactor = noDecay;
+					decayFactor = 1e6f;// no decay
 				}
 			}
-			if (decayFactor != noDecay) {
-				for (int i = 0; i < compactedSize; i++) {
-					if (fftOut[i] > drawBufLin[i]) {
-						drawBufLin[i] = fftOut[i];
-					}
-					else {
-						drawBufLin[i] += (fftOut[i] - drawBufLin[i]) * decayFactor * FFT_N_2 / trackEqs[0].getSampleRate();// decay
-					}
-				}
-			}
-			else {
-				memcpy(&drawBufLin[0], &fftOut[0], compactedSize * 4);
-			}
-			
-			// calculate log of magnitude and transfer to drawBuf
-			for (int x = 0; x < ((compactedSize + 3) >> 2) ; x++) {
-				simd::float_4 vecp = simd::float_4::load(&drawBufLin[x << 2]);
-				vecp = simd::fmax(vertScaling * 20.0f * simd::log10(vecp) + vertOffset, -1.0f);// fmax for proper enclosed region for fill
-				vecp.store(&drawBuf[x << 2]);					
+			float decayCoeff = std::fmin(decayFactor * hop / trackEqs[0].getSampleRate(), 1.0f);
+			int ballistics = clamp((int)miscSettings3.cc4[3], 0, NUM_SPEC_BALL - 1);
+			if (ballistics != drawBufLinBallistics) {
+				decayCoeff = 1.0f;// restart from this frame
+				drawBufLinBallistics = ballistics;
 			}
+			smoothSpectrum(drawBuf, drawBufLin, fftOut, compactedSize, ballistics, decayCoeff, specLog2Scaling, specVertOffset);
 		
 			drawBufSize = compactedSize;
-
-			requestWork = false;
 		}
 	}	
 
@@ -619,16 +760,29 @@ struct EqMaster : Module {
 											(MfeExpInterface*)leftExpander.consumerMessage;
 			
 			// track band values
-			int index6 = clamp(messagesFromExpander->trackCvsIndex6, 0, 5);
-			int cvConnectedSubset = messagesFromExpander->trackCvsConnected;
-			for (int i = 0; i < 4; i++) {
-				if ((cvConnectedSubset & (1 << i)) != 0) {
-					int bandTrkIndex = (index6 << 2) + i;
-					processTrackBandCvs(bandTrkIndex, selectedTrack, &(messagesFromExpander->trackCvs[16 * i]));
+			if (messagesFromExpander->trackCvsAll) {
+				// audio-rate band cvs, each track refreshed at fs (the eq coefficients follow at most every 4 samples, see TrackEq::setCoeffUpdateInterval())
+				int cvConnectedAll = messagesFromExpander->trackCvsConnected & 0xFFFFFF;
+				for (int t = 0; t < 24; t++) {
+					if ((cvConnectedAll & (1 << t)) != 0) {
+						processTrackBandCvs(t, selectedTrack, &(messagesFromExpander->trackCvs[16 * t]));
+					}
+				}
+				cvConnected = cvConnectedAll;
+			}
+			else {
+				// each track refreshed at fs / 6
+				int index6 = clamp(messagesFromExpander->trackCvsIndex6, 0, 5);
+				int cvConnectedSubset = messagesFromExpander->trackCvsConnected;
+				for (int i = 0; i < 4; i++) {
+					if ((cvConnectedSubset & (1 << i)) != 0) {
+						int bandTrkIndex = (index6 << 2) + i;
+						processTrackBandCvs(bandTrkIndex, selectedTrack, &(messagesFromExpander->trackCvs[16 * i]));
+					}
 				}
+				cvConnected &= ~(0xF << (index6 << 2));// clear all connected bits for current subset
+				cvConnected |= (cvConnectedSubset << (index6 << 2));// set relevant connected bits for current subset
 			}
-			cvConnected &= ~(0xF << (index6 << 2));// clear all connected bits for current subset
-			cvConnected |= (cvConnectedSubset << (index6 << 2));// set relevant connected bits for current subset
  
 			// track enables, each track refreshed at fs / 25
 			int enableTrkIndex = clamp(messagesFromExpander->trackEnableIndex, 0, 24);
@@ -648,12 +802,13 @@ struct EqMaster : Module {
 		//********** Outputs **********
 
 		bool vuProcessed = false;
+		bool globalEnable = params[GLOBAL_BYPASS_PARAM].getValue() < 0.5f;
 		for (int i = 0; i < 3; i++) {
 			if (inputs[SIG_INPUTS + i].isConnected()) {
+				float outs[16];// eq'd tracks, also read by the multi-track spectrum below
 				for (int t = 0; t < 8; t++) {
 					float* in = inputs[SIG_INPUTS + i].getVoltages((t << 1) + 0);
-					float out[2];
-					bool globalEnable = params[GLOBAL_BYPASS_PARAM].getValue() < 0.5f;
+					float* out = &outs[t << 1];
 					trackEqs[(i << 3) + t].process(out, in, globalEnable);
 					outputs[SIG_OUTPUTS + i].setVoltage(out[0], (t << 1) + 0);
 					outputs[SIG_OUTPUTS + i].setVoltage(out[1], (t << 1) + 1);
@@ -668,36 +823,31 @@ struct EqMaster : Module {
 												(in[0] + in[1]) : 
 												(out[0] + out[1]));// no need to div by two, scaling done later
 							
-							// write sample into fft input buffers and apply windowing
-							fftIn[page][fftWriteHead] = sample * windowFunc[fftWriteHead >= FFT_N_2 ? ((FFT_N - 1) - fftWriteHead) : fftWriteHead];// * dsp::blackmanHarris((float)fftWriteHead / (float)(FFT_N - 1));
-							if (fftWriteHead >= FFT_N_2) {
-								int offsetHead = fftWriteHead - FFT_N_2;
-								fftIn[(page + 1) % 3][offsetHead] = sample * windowFunc[offsetHead];// * dsp::blackmanHarris((float)offsetHead / (float)(FFT_N - 1));
-							}	
-							
-							// increment write head and possibly page
-							fftWriteHead++;
-							if (fftWriteHead >= FFT_N) {
-								fftWriteHead = FFT_N_2;
-								//thread 
-								if (requestWork) {
-									// INFO("FFT too slow, page skipped");
-								}
-								else {
-									requestPage = page;
-									requestWork = true;
-									cv.notify_one();
-								}
-								page++;
-								if (page >= 3) {
-									page = 0;
-								}
-							}
+							// to the worker, which does the windowing
+							fftInputs.write(sample);
+						}// Spectrum
+					}
+				}
+				
+				// Multi-track spectrum, when the worker has requested one of these two track quads
+				for (int q = 0; q < 2; q++) {
+					if (fftQuadCapture.isRequested((i << 1) + q)) {
+						if ( (miscSettings.cc4[1] & (SPEC_MASK_ON | SPEC_MASK_FREEZE)) == SPEC_MASK_ON ) {
+							float* src = ((miscSettings.cc4[1] & SPEC_MASK_POST) == 0 ? inputs[SIG_INPUTS + i].getVoltages(q << 3) : &outs[q << 3]);
+							simd::float_4 src01 = simd::float_4::load(&src[0]);// L0 R0 L1 R1
+							simd::float_4 src23 = simd::float_4::load(&src[4]);// L2 R2 L3 R3
+							fftQuadCapture.write(_mm_hadd_ps(src01.v, src23.v));// L + R of the four tracks
 						}
 						else {
-							fftWriteHead = 0;
-							page = 0;
-						}// Spectrum
+							fftQuadCapture.skip();
+						}
+					}
+				}
+			}
+			else {
+				for (int q = 0; q < 2; q++) {
+					if (fftQuadCapture.isRequested((i << 1) + q)) {
+						fftQuadCapture.skip();
 					}
 				}
 			}
@@ -803,9 +953,10 @@ struct EqMaster : Module {
 
 
 struct EqMasterWidget : ModuleWidget {
-	time_t oldTime = 0;
 	int oldMappedId = 0;
+	uint32_t oldMappedGeneration = 0;
 	int oldSelectedTrack = -1;
+	bool oldSpecOn = false;
 	TrackLabel* trackLabel;
 	int lastMovedKnobId = -1;
 	time_t lastMovedKnobTime = 0;
@@ -838,6 +989,31 @@ struct EqMasterWidget : ModuleWidget {
 		decayItem->decayRateSrc = &(module->miscSettings2.cc4[1]);
 		menu->addChild(decayItem);
 
+		BallisticsItem *ballisticsItem = createMenuItem<BallisticsItem>("Analyser ballistics", RIGHT_ARROW);
+		ballisticsItem->ballisticsSrc = &(module->miscSettings3.cc4[3]);
+		menu->addChild(ballisticsItem);
+
+		FftSizeItem *fftSizeItem = createMenuItem<FftSizeItem>("Analyser resolution", RIGHT_ARROW);
+		fftSizeItem->fftLog2NSrc = &(module->miscSettings3.cc4[0]);
+		menu->addChild(fftSizeItem);
+
+		FftOverlapItem *fftOverlapItem = createMenuItem<FftOverlapItem>("Analyser overlap", RIGHT_ARROW);
+		fftOverlapItem->fftOverlapSrc = &(module->miscSettings3.cc4[1]);
+		menu->addChild(fftOverlapItem);
+
+		MultiSpecItem *multiSpecItem = createMenuItem<MultiSpecItem>("Analyser tracks", RIGHT_ARROW);
+		multiSpecItem->multiSpecSrc = &(module->miscSettings3.cc4[2]);
+		multiSpecItem->multiSpecTracksSrc = &(module->multiSpecTracks);
+		multiSpecItem->trackLabelsSrc = module->trackLabels;
+		menu->addChild(multiSpecItem);
+
+		uint32_t droppedFrames = module->fftInputs.getDroppedFrames();
+		if (droppedFrames != 0) {
+			MenuLabel *droppedLabel = new MenuLabel();
+			droppedLabel->text = string::f("Analyser frames dropped: %u", droppedFrames);
+			menu->addChild(droppedLabel);
+		}
+
 		HideEqWhenBypassItem *hideeqItem = createMenuItem<HideEqWhenBypassItem>("Hide EQ curves when bypassed", CHECKMARK(module->miscSettings2.cc4[2] != 0));
 		hideeqItem->hideEqWhenBypass = &(module->miscSettings2.cc4[2]);
 		menu->addChild(hideeqItem);
@@ -931,6 +1107,11 @@ struct EqMasterWidget : ModuleWidget {
 			eqCurveAndGrid->bandParamsCvConnected = &bandParamsCvConnected;
 			eqCurveAndGrid->drawBuf = module->drawBuf;
 			eqCurveAndGrid->drawBufSize = &(module->drawBufSize);
+			eqCurveAndGrid->miscSettings3Src = &(module->miscSettings3);
+			eqCurveAndGrid->trackSpecs = module->trackSpecs;
+			eqCurveAndGrid->trackSpecsX = module->trackSpecsX;
+			eqCurveAndGrid->trackSpecsSize = module->trackSpecsSize;
+			eqCurveAndGrid->trackLabelColorsSrc = module->trackLabelColors;
 			eqCurveAndGrid->lastMovedKnobIdSrc = &lastMovedKnobId;
 			eqCurveAndGrid->lastMovedKnobTimeSrc = &lastMovedKnobTime;
 		}
@@ -1064,20 +1245,25 @@ struct EqMasterWidget : ModuleWidget {
 		if (module) {
 			int trk = module->getSelectedTrack();			
 			
-			// update labels from message bus at 1Hz
-			time_t currentTime = time(0);
-			if (currentTime != oldTime) {
-				oldTime = currentTime;
-
+			// update labels from message bus when the mapped mixer changed or published new labels or colors, 
+			//   or when the module asks for its labels to be pulled (its own labels may have been reloaded)
+			uint32_t mappedGeneration = module->mappedId == 0 ? 0 : mixerMessageBus.getGeneration(module->mappedId);
+			if (module->mappedId != oldMappedId || mappedGeneration != oldMappedGeneration || module->updateTrackLabelRequest != 0) {
 				if (module->mappedId == 0) {
 					if (oldMappedId != 0) {
 						module->initTrackLabelsAndColors();
 					}
+					oldMappedGeneration = 0;
 				}
 				else {
 					MixerMessage message;
 					message.id = module->mappedId;
-					mixerMessageBus.receive(&message);
+					if (mixerMessageBus.receive(&message)) {
+						oldMappedGeneration = mappedGeneration;// only once received, so that a failed read is retried on the next step
+					}
+					else {
+						message.id = 0;// sender busy, keep the current labels and colors as when deregistered
+					}
 					if (message.id == 0) {// if deregistered
 						// do nothing! since it may be possible that the eq is loaded and step executes before the mixer modules are finished loading
 						// module->initTrackLabelsAndColors();
@@ -1149,11 +1335,18 @@ struct EqMasterWidget : ModuleWidget {
 						}
 					}
 				}
-				module->updateTrackLabelRequest = 1;
+				raiseTrackLabelRequest(&(module->updateTrackLabelRequest), 1);// keeps a pending init track refresh
 				
 				oldMappedId = module->mappedId;
 			}
 
+			// Analyser worker, parked while the analyser is off
+			bool specOn = (module->miscSettings.cc4[1] & SPEC_MASK_ON) != 0;
+			if (specOn && !oldSpecOn) {
+				module->wakeWorker();
+			}
+			oldSpecOn = specOn;
+
 			// Track label (pull from module or this step method)
 			if (module->updateTrackLabelRequest != 0) {// pull request from module
 				if (module->updateTrackLabelRequest > 1) {
@@ -9,13 +9,15 @@
 
 #include "MindMeldModular.hpp"
 #include "dsp/QuattroBiQuad.hpp"
+#include <atomic>
 
 
 struct MfeExpInterface {// for messages to mother from expander
 	int trackCvsIndex6 = 0;
 	int trackEnableIndex = 0;
-	int trackCvsConnected = 0;// only 4 lsbits used
-	float trackCvs[16 * 4] = {0.0f};// room for 4 poly cables
+	int trackCvsConnected = 0;// only 4 lsbits used (24 lsbits used when trackCvsAll)
+	bool trackCvsAll = false;// audio-rate band cvs: trackCvs has the cvs of all 24 tracks every sample, and trackCvsIndex6 is unused
+	float trackCvs[16 * 24] = {0.0f};// room for 4 poly cables (24 when trackCvsAll); only connected cables are written
 	float trackEnable = 0.0f;// one of the 24+1 enable cvs
 };
 	
@@ -53,8 +55,19 @@ static const bool DEFAULT_lowPeak = false;
 static const bool DEFAULT_highPeak = false;
 static const float DEFAULT_trackGain = 0.0f;// dB
 
-static const int FFT_N = 2048;// must be a multiple of 32 (if adjust this, should adjust left side spectrum cheating when drawing which was setup with 2048)
-static const int FFT_N_2 = FFT_N >> 1;
+// EqMaster::updateTrackLabelRequest is 0 when nothing to do, 1 for read names in widget, 2 for same as 1 but force param refreshing;
+//   a request is only ever raised, so that a pending 2 is not lost to a 1 written before the widget pulls it
+static inline void raiseTrackLabelRequest(int* updateTrackLabelRequest, int request) {
+	if (*updateTrackLabelRequest < request) {
+		*updateTrackLabelRequest = request;
+	}
+}
+
+static const int FFT_LOG2_N_MIN = 10;// fft sizes are 1024 to 16384 (the left side spectrum cheating when drawing was setup with 2048)
+static const int FFT_LOG2_N_MAX = 14;
+static const int FFT_LOG2_N_DEFAULT = 11;
+static const int FFT_N_MAX = 1 << FFT_LOG2_N_MAX;
+static const int DRAW_BUF_N_2 = 1024;// max compacted freq bins in a drawBuf, more than the pixel width of the spectrum
 
 // static constexpr float minFreq = 20.0f;// update minLogFreq when changing this !
 static constexpr float minLogFreq = 1.30103f;// std::log10(minFreq);// commented for old compilers
@@ -79,6 +92,7 @@ class TrackEq {
 	// automatically managed internally by member functions
 	int dirty;// 4 bits, one for each band (automatically managed by member methods, no need to handle in init() and copyFrom())
 	QuattroBiQuad::Type bandTypes[4]; // only [0] and [3] are dependants, [1] and [2] are set to their permanent values in init()
+	int coeffUpdateInterval;// in samples, 1 updates the eq coefficients as soon as a parameter moves
 	
 	// need saving
 	bool trackActive;
@@ -115,6 +129,7 @@ class TrackEq {
 		bandTypes[1] = QuattroBiQuad::PEAK;
 		bandTypes[2] = QuattroBiQuad::PEAK;
 		highPeak = !DEFAULT_highPeak;// to force bandTypes[3] to be set when first init() will call setLowPeak()
+		coeffUpdateInterval = 1;
 		freqSlewers.setRiseFall(simd::float_4(antipopSlewLogHz)); // slew rate is in input-units per second (ex: V/s)
 		gainSlewers.setRiseFall(simd::float_4(antipopSlewDb)); // slew rate is in input-units per second (ex: V/s)
 		trackGainSlewer.setRiseFall(antipopSlewDb);
@@ -283,6 +298,9 @@ class TrackEq {
 		if (trackGain != DEFAULT_trackGain) return true;
 		return false;
 	}
+	void setCoeffUpdateInterval(int _coeffUpdateInterval) {coeffUpdateInterval = _coeffUpdateInterval;}
+	
+	
 	void process(float* out, float* in, bool globalEnable) {
 		bool _cvConnected = getCvConnected();
 		
@@ -309,19 +327,17 @@ class TrackEq {
 			dirty |= ~gainSlewersComparisonMask;
 		}
 		
-		// update eq parameters according to dirty flags
-		if (dirty != 0) {
+		// update eq parameters according to dirty flags, all four bands in one pass; when coeffUpdateInterval > 1, 
+		//   the coefficients are recalculated at most once every coeffUpdateInterval samples and ramped in between
+		eqs.stepCoefficients();
+		if (dirty != 0 && !eqs.isCoeffRamping()) {
 			simd::float_4 normalizedFreq = simd::fmin(0.5f, simd::pow(10.0f, freqSlewers.out) / sampleRate);
 			simd::float_4 linearGain = simd::pow(10.0f, gainSlewers.out / 20.0f);
 			simd::float_4 qWithCv = getQWithCvVec(_cvConnected);
-			for (int b = 0; b < 4; b++) {
-				if ((dirty & (1 << b)) != 0) {
-					eqs.setParameters(b, bandTypes[b], normalizedFreq[b], linearGain[b], qWithCv[b]);
-				}
-			}
+			eqs.setParameters(bandTypes, normalizedFreq, linearGain, qWithCv, coeffUpdateInterval);
+			dirty = 0x0;
 		}
-		dirty = 0x0;		
-				
+		
 		// perform equalization		
 		eqs.process(out, in);
 		
@@ -337,3 +353,278 @@ class TrackEq {
 		}
 	}
 };
+
+
+// Mapping of the fft bins to the pixel columns of the spectrum (compacted bins): each compacted bin is the range of 
+//   consecutive fft bins that have the same pixel x (round of the rescaled log freq, bins under minLogFreq all go to pixel 0).
+//   Only recalculated when the fft size or the sample rate change, so a frame is just magnitudes and a max per range.
+class SpectrumBinLut {
+	int fftN;
+	float sampleRate;
+	int size;// number of compacted bins
+	int binStart[DRAW_BUF_N_2 + 1];// first fft bin of each compacted bin, binStart[size] is the end of the last one
+	float x[DRAW_BUF_N_2];// pixel x of each compacted bin
+	
+	
+	public:
+	
+	SpectrumBinLut() {
+		fftN = 0;
+		sampleRate = 0.0f;
+		size = 0;
+	}
+	
+	int getSize() {return size;}
+	float* getX() {return x;}
+	
+	void update(int _fftN, float _sampleRate) {
+		if (fftN == _fftN && sampleRate == _sampleRate) {
+			return;
+		}
+		fftN = _fftN;
+		sampleRate = _sampleRate;
+		
+		int fftN_2 = fftN >> 1;
+		int i = 0;// index into compacted bins
+		for (int b = 0; b < fftN_2; b++) {// index into fft bins
+			float linFreq = ((float)b / ((float)(fftN - 1))) * sampleRate;
+			float pixelX = std::round(std::fmax(math::rescale(std::log10(linFreq), minLogFreq, maxLogFreq, 0.0f, eqCurveWidth), 0.0f));
+			if (i != 0 && x[i - 1] == pixelX) {
+				continue;
+			}
+			if (i >= DRAW_BUF_N_2) {
+				binStart[i] = b;
+				size = i;
+				return;
+			}
+			binStart[i] = b;
+			x[i] = pixelX;
+			i++;
+		}
+		binStart[i] = fftN_2;
+		size = i;
+	}
+	
+	int compact(float* fftData) {
+		// fftData[fftN]: ordered fft output, replaced by the squared magnitudes of the compacted bins (the max of their fft bins)
+		// returns the number of compacted bins
+		
+		// squared magnitudes (sqrt is not needed since when take log of this, it can be absorbed in scaling multiplier)
+		for (int b = 0; b < fftN; b += 8) {
+			simd::float_4 v0 = simd::float_4::load(&fftData[b + 0]);// re0 im0 re1 im1
+			simd::float_4 v1 = simd::float_4::load(&fftData[b + 4]);// re2 im2 re3 im3
+			v0 *= v0;
+			v1 *= v1;
+			simd::float_4(_mm_hadd_ps(v0.v, v1.v)).store(&fftData[b >> 1]);
+		}
+		
+		// max of each range, in place since a range never starts before its compacted bin
+		for (int i = 0; i < size; i++) {
+			int b = binStart[i];
+			int end = binStart[i + 1];
+			float maxMag = fftData[b];
+			b++;
+			if (end - b >= 4) {
+				simd::float_4 maxMag4 = simd::float_4::load(&fftData[b]);// unaligned loads, see Rack's simd::float_4::load()
+				for (b += 4; b + 4 <= end; b += 4) {
+					maxMag4 = simd::fmax(maxMag4, simd::float_4::load(&fftData[b]));
+				}
+				maxMag = std::fmax(maxMag, std::fmax(std::fmax(maxMag4[0], maxMag4[1]), std::fmax(maxMag4[2], maxMag4[3])));
+			}
+			for (; b < end; b++) {
+				maxMag = std::fmax(maxMag, fftData[b]);
+			}
+			fftData[i] = maxMag;
+		}
+		return size;
+	}
+};
+
+
+enum SpecBallistics {SPEC_BALL_PEAK, SPEC_BALL_RMS, SPEC_BALL_EXP, NUM_SPEC_BALL};
+
+// Smoothing of the compacted squared magnitudes of a new frame into state, and conversion to pixel scaled dB into dest
+//   peak: instant attack, decays towards the frame (state is power)
+//   RMS: one-pole average of the power
+//   exponential: one-pole average of the log2 power, so the same time in dB for rises and falls
+// coeff is the portion of the way towards the frame (0 holds, 1 is no smoothing), log2Scaling is the pixels per log2 of power
+// size is rounded up to a multiple of 4, the buffers must have room for this
+static void smoothSpectrum(float* dest, float* state, const float* mags, int size, int ballistics, float coeff, float log2Scaling, float offset) {
+	if (ballistics == SPEC_BALL_EXP) {
+		for (int i = 0; i < size; i += 4) {
+			simd::float_4 st = simd::float_4::load(&state[i]);
+			st += (log2Fast(simd::float_4::load(&mags[i])) - st) * coeff;
+			st.store(&state[i]);
+			simd::fmax(st * log2Scaling + offset, -1.0f).store(&dest[i]);// fmax for proper enclosed region for fill
+		}
+	}
+	else {
+		simd::float_4 attackMask = (ballistics == SPEC_BALL_PEAK ? simd::float_4::mask() : simd::float_4::zero());
+		for (int i = 0; i < size; i += 4) {
+			simd::float_4 mag = simd::float_4::load(&mags[i]);
+			simd::float_4 st = simd::float_4::load(&state[i]);
+			st = simd::ifelse(attackMask & (mag > st), mag, st + (mag - st) * coeff);
+			st.store(&state[i]);
+			simd::fmax(log2Fast(st) * log2Scaling + offset, -1.0f).store(&dest[i]);
+		}
+	}
+}
+
+
+// Wait-free single-producer single-consumer ring of spectrum input samples, from the audio thread to the fft worker.
+//   The audio thread only stores samples, it never blocks or signals; the worker reads overlapping frames of any size 
+//   up to FFT_N_MAX with any hop, applies the window, and counts the frames it drops when it falls too far behind.
+class FftInputRing {
+	static const uint32_t CAPACITY = FFT_N_MAX * 2;// power of 2, so the worker can lag by FFT_N_MAX samples before dropping
+	
+	float* buf;// [CAPACITY]
+	std::atomic<uint32_t> writeCount;// samples written, only written by the audio thread
+	std::atomic<uint32_t> droppedFrames;// only written by the worker
+	uint32_t nextFrameEnd;// worker only
+	
+	
+	public:
+	
+	FftInputRing() {
+		buf = (float*)pffft_aligned_malloc(CAPACITY * 4);
+		for (uint32_t i = 0; i < CAPACITY; i++) {
+			buf[i] = 0.0f;
+		}
+		writeCount.store(0);
+		droppedFrames.store(0);
+		nextFrameEnd = 1 << FFT_LOG2_N_DEFAULT;
+	}
+	
+	~FftInputRing() {
+		pffft_aligned_free(buf);
+	}
+	
+	uint32_t getDroppedFrames() {
+		return droppedFrames.load(std::memory_order_relaxed);
+	}
+	
+	
+	// audio thread
+	
+	void write(float sample) {
+		uint32_t w = writeCount.load(std::memory_order_relaxed);
+		buf[w & (CAPACITY - 1)] = sample;
+		writeCount.store(w + 1, std::memory_order_release);
+	}
+	
+	
+	// fft worker
+	
+	void restart(int n) {// next frame ends n samples from now
+		nextFrameEnd = writeCount.load(std::memory_order_acquire) + n;
+	}
+	
+	bool readFrame(float* dest, float* windowFunc, int n, int hop) {
+		// dest[n] gets the next frame, hop samples after the previous one, with the window applied 
+		//   (windowFunc[n / 2] is the first half of a symetrical window); returns false when the frame is not complete yet
+		uint32_t w = writeCount.load(std::memory_order_acquire);
+		if ((int32_t)(w - nextFrameEnd) < 0) {
+			return false;
+		}
+		uint32_t frameEnd = nextFrameEnd;
+		uint32_t late = w - frameEnd;
+		if (late > CAPACITY - n) {
+			// start of the frame already overwritten, skip to the most recent complete frame
+			uint32_t skipped = late / hop;
+			frameEnd += skipped * hop;
+			droppedFrames.store(droppedFrames.load(std::memory_order_relaxed) + skipped, std::memory_order_relaxed);
+		}
+		nextFrameEnd = frameEnd + hop;
+		
+		uint32_t frameStart = frameEnd - n;
+		int n_2 = n >> 1;
+		for (int i = 0; i < n_2; i++) {
+			dest[i] = buf[(frameStart + i) & (CAPACITY - 1)] * windowFunc[i];
+		}
+		for (int i = n_2; i < n; i++) {
+			dest[i] = buf[(frameStart + i) & (CAPACITY - 1)] * windowFunc[(n - 1) - i];
+		}
+		
+		// the audio thread may have overwritten the start of the frame while it was being read
+		if (writeCount.load(std::memory_order_acquire) - frameStart > CAPACITY) {
+			droppedFrames.store(droppedFrames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
+};
+
+
+// Wait-free capture of the spectrum inputs of four tracks at once (one float_4 per sample), from the audio thread to the fft worker.
+//   The worker requests a track quad and a frame size, the audio thread fills the frame and marks it done; 
+//   a request for a quad that is not being processed (unconnected input, spectrum off) is marked done and not valid.
+class FftQuadCapture {
+	simd::float_4* buf;// [FFT_N_MAX]
+	std::atomic<int> state;// the audio thread only touches the members below when REQUESTED, the worker only when not
+	int quad;
+	int n;
+	int writeHead;
+	bool valid;
+	
+	
+	public:
+	
+	enum CaptureStates {IDLE, REQUESTED, DONE};
+	
+	FftQuadCapture() {
+		buf = (simd::float_4*)pffft_aligned_malloc(FFT_N_MAX * sizeof(simd::float_4));
+		state.store(IDLE);
+		quad = 0;
+		n = 0;
+		writeHead = 0;
+		valid = false;
+	}
+	
+	~FftQuadCapture() {
+		pffft_aligned_free(buf);
+	}
+	
+	
+	// audio thread
+	
+	bool isRequested(int trkQuad) {
+		return state.load(std::memory_order_acquire) == REQUESTED && quad == trkQuad;
+	}
+	
+	void write(simd::float_4 samples) {// only when isRequested()
+		buf[writeHead] = samples;
+		writeHead++;
+		if (writeHead >= n) {
+			valid = true;
+			state.store(DONE, std::memory_order_release);
+		}
+	}
+	
+	void skip() {// only when isRequested()
+		valid = false;
+		state.store(DONE, std::memory_order_release);
+	}
+	
+	
+	// fft worker
+	
+	int getState() {
+		return state.load(std::memory_order_acquire);
+	}
+	
+	void request(int _quad, int _n) {// only when not REQUESTED
+		quad = _quad;
+		n = _n;
+		writeHead = 0;
+		state.store(REQUESTED, std::memory_order_release);
+	}
+	
+	// the following only when DONE
+	int getQuad() {return quad;}
+	int getN() {return n;}
+	bool isValid() {return valid;}
+	simd::float_4* getBuf() {return buf;}
+	void release() {
+		state.store(IDLE, std::memory_order_relaxed);
+	}
+};
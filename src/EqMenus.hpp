@@ -143,8 +143,10 @@ struct FetchLabelsItem : MenuItem {
 
 		bool sawMappedId = *mappedIdSrc == 0;
 		
-		std::vector<MessageBase>* mixerMessageSurvey = mixerMessageBus.surveyValues();
-		for (MessageBase pl : *mixerMessageSurvey) {
+		MessageBase mixerMessageSurvey[MixerMessageBus::MAX_MEMBERS];
+		int numMixers = mixerMessageBus.surveyValues(mixerMessageSurvey, MixerMessageBus::MAX_MEMBERS);
+		for (int i = 0; i < numMixers; i++) {
+			MessageBase& pl = mixerMessageSurvey[i];
 			if (*mappedIdSrc == pl.id) {
 				sawMappedId = true;
 			}
@@ -154,7 +156,6 @@ struct FetchLabelsItem : MenuItem {
 			idItem->setId = pl.id;
 			menu->addChild(idItem);
 		}
-		delete mixerMessageSurvey;
 		
 		if (!sawMappedId) {
 			std::string mixerName = std::string("[deleted]") + string::f("  (id %d)", *mappedIdSrc);
@@ -177,7 +178,7 @@ struct InitializeEqTrackItem : MenuItem {
 	TEqTrack *srcTrack;
 	void onAction(const event::Action &e) override {
 		srcTrack->onReset();
-		*updateTrackLabelRequestSrc = 2;// force param refreshing
+		raiseTrackLabelRequest(updateTrackLabelRequestSrc, 2);// force param refreshing
 	}
 };
 
@@ -248,6 +249,147 @@ struct DecayRateItem : MenuItem {
 	}
 };
 
+struct BallisticsItem : MenuItem {
+	int8_t *ballisticsSrc;
+
+	struct BallisticsSubItem : MenuItem {
+		int8_t *ballisticsSrc;
+		int8_t setVal;
+		void onAction(const event::Action &e) override {
+			*ballisticsSrc = setVal;
+		}
+	};
+
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+
+		std::string ballisticsNames[NUM_SPEC_BALL] = {
+			"Peak hold (default)",
+			"RMS average",
+			"Exponential"
+		};
+		
+		for (int i = 0; i < NUM_SPEC_BALL; i++) {
+			BallisticsSubItem *balItem = createMenuItem<BallisticsSubItem>(ballisticsNames[i], CHECKMARK(*ballisticsSrc == i));
+			balItem->ballisticsSrc = ballisticsSrc;
+			balItem->setVal = i;
+			menu->addChild(balItem);
+		}
+		
+		return menu;
+	}
+};
+
+struct FftSizeItem : MenuItem {
+	int8_t *fftLog2NSrc;
+
+	struct FftSizeSubItem : MenuItem {
+		int8_t *fftLog2NSrc;
+		int8_t setVal;
+		void onAction(const event::Action &e) override {
+			*fftLog2NSrc = setVal;
+		}
+	};
+
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+
+		for (int i = FFT_LOG2_N_MIN; i <= FFT_LOG2_N_MAX; i++) {
+			std::string fftSizeName = string::f("%i points", 1 << i);
+			if (i == FFT_LOG2_N_DEFAULT) {
+				fftSizeName += " (default)";
+			}
+			FftSizeSubItem *fsItem = createMenuItem<FftSizeSubItem>(fftSizeName, CHECKMARK(*fftLog2NSrc == i));
+			fsItem->fftLog2NSrc = fftLog2NSrc;
+			fsItem->setVal = i;
+			menu->addChild(fsItem);
+		}
+		
+		return menu;
+	}
+};
+
+struct FftOverlapItem : MenuItem {
+	int8_t *fftOverlapSrc;
+
+	struct FftOverlapSubItem : MenuItem {
+		int8_t *fftOverlapSrc;
+		int8_t setVal;
+		void onAction(const event::Action &e) override {
+			*fftOverlapSrc = setVal;
+		}
+	};
+
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+
+		std::string fftOverlapNames[2] = {
+			"50% (default)",
+			"75%"
+		};
+		
+		for (int i = 0; i < 2; i++) {
+			FftOverlapSubItem *foItem = createMenuItem<FftOverlapSubItem>(fftOverlapNames[i], CHECKMARK(*fftOverlapSrc == i));
+			foItem->fftOverlapSrc = fftOverlapSrc;
+			foItem->setVal = i;
+			menu->addChild(foItem);
+		}
+		
+		return menu;
+	}
+};
+
+struct MultiSpecItem : MenuItem {
+	int8_t *multiSpecSrc;
+	uint32_t *multiSpecTracksSrc;
+	char *trackLabelsSrc;
+
+	struct MultiSpecSubItem : MenuItem {
+		int8_t *multiSpecSrc;
+		int8_t setVal;
+		void onAction(const event::Action &e) override {
+			*multiSpecSrc = setVal;
+		}
+	};
+
+	struct MultiSpecTrackSubItem : MenuItem {
+		uint32_t *multiSpecTracksSrc;
+		int trk;
+		void onAction(const event::Action &e) override {
+			*multiSpecTracksSrc ^= (1 << trk);
+		}
+	};
+
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+
+		std::string multiSpecNames[3] = {
+			"Selected track only (default)",
+			"All active tracks",
+			"Chosen tracks"
+		};
+		
+		for (int i = 0; i < 3; i++) {
+			MultiSpecSubItem *msItem = createMenuItem<MultiSpecSubItem>(multiSpecNames[i], CHECKMARK(*multiSpecSrc == i));
+			msItem->multiSpecSrc = multiSpecSrc;
+			msItem->setVal = i;
+			menu->addChild(msItem);
+		}
+		
+		if (*multiSpecSrc == 2) {
+			menu->addChild(new MenuSeparator());
+			for (int t = 0; t < 24; t++) {
+				MultiSpecTrackSubItem *mstItem = createMenuItem<MultiSpecTrackSubItem>(std::string(&trackLabelsSrc[t << 2], 4), CHECKMARK((*multiSpecTracksSrc & (1 << t)) != 0));
+				mstItem->multiSpecTracksSrc = multiSpecTracksSrc;
+				mstItem->trk = t;
+				menu->addChild(mstItem);
+			}
+		}
+		
+		return menu;
+	}
+};
+
 struct HideEqWhenBypassItem : MenuItem {
 	int8_t *hideEqWhenBypass;
 	void onAction(const event::Action &e) override {
@@ -491,8 +491,96 @@ struct EqCurveAndGrid : LightWidget {// TransparentWidget {
 	static constexpr float minDb = -20.0f;
 	static constexpr float maxDb = 20.0f;
 	static const int numDrawSteps = 200;
+
+	// static layers, drawn in framebuffers (see gridFb and gridTextFb) so that they are not redrawn every frame
+	struct GridLayer : TransparentWidget {
+		// grid lines
+		void vertLineAtFreq(const DrawArgs &args, float freq) {
+			float logFreq = std::log10(freq);
+			float lineX = math::rescale(logFreq, minLogFreq, maxLogFreq, 0.0f, box.size.x);
+			nvgMoveTo(args.vg, lineX, 0.0f);
+			nvgLineTo(args.vg, lineX, box.size.y);
+		}
+		void horzLineAtDb(const DrawArgs &args, float dB) {
+			float lineY = math::rescale(dB, minDb, maxDb, box.size.y, 0.0f);
+			nvgMoveTo(args.vg, 0.0f, lineY);
+			nvgLineTo(args.vg, box.size.x, lineY);
+		}
+		void draw(const DrawArgs &args) override {
+			NVGcolor lineCol = nvgRGB(0x37, 0x37, 0x37);
+			NVGcolor screenCol = nvgRGB(38, 38, 38);
+			nvgStrokeColor(args.vg, lineCol);
+			nvgStrokeWidth(args.vg, 0.7f);
+		
+			// vertical lines
+			NVGpaint grad = nvgLinearGradient(args.vg, 0.0f, box.size.y * 34.0f / 40.0f, 0.0f, box.size.y, lineCol, screenCol);
+			nvgBeginPath(args.vg);
+			vertLineAtFreq(args, 30.0f);
+			vertLineAtFreq(args, 40.0f);
+			vertLineAtFreq(args, 50.0f);
+			for (int i = 1; i <= 5; i++) {
+				vertLineAtFreq(args, 100.0f * (float)i);
+				vertLineAtFreq(args, 1000.0f * (float)i);
+			}
+			vertLineAtFreq(args, 10000.0f);
+			vertLineAtFreq(args, 20000.0f);
+			nvgStrokePaint(args.vg, grad);
+			nvgStroke(args.vg);
+		
+			// horizontal lines
+			nvgBeginPath(args.vg);
+			horzLineAtDb(args, 20.0f);
+			horzLineAtDb(args, 12.0f);
+			horzLineAtDb(args, 6.0f);
+			horzLineAtDb(args, 0.0f);
+			horzLineAtDb(args, -6.0f);
+			horzLineAtDb(args, -12.0f);
+			//nvgRect(args.vg, 0.0f, 0.0f, box.size.x, box.size.y);
+			nvgStroke(args.vg);	
+		}
+	};
+	struct GridTextLayer : TransparentWidget {
+		std::shared_ptr<Font> font;
+		bool hideDb = false;
+		
+		// text labels in grid lines
+		void textAtFreqAndDb(const DrawArgs &args, float freq, float dB, std::string text) {
+			float logFreq = std::log10(freq);
+			float textX = math::rescale(logFreq, minLogFreq, maxLogFreq, 0.0f, box.size.x);
+			float textY = math::rescale(dB, minDb, maxDb, box.size.y, 0.0f);
+			nvgText(args.vg, textX, textY - 3.0f, text.c_str(), NULL);
+		}
+		void draw(const DrawArgs &args) override {
+			// text labels
+			if (font->handle >= 0) {
+				nvgFillColor(args.vg, nvgRGB(0x97, 0x97, 0x97));
+				nvgFontFaceId(args.vg, font->handle);
+				nvgTextLetterSpacing(args.vg, 0.0);
+				nvgFontSize(args.vg, 9.0f);
+				nvgTextAlign(args.vg, NVG_ALIGN_CENTER);
+				// frequency
+				textAtFreqAndDb(args, 50.0f, -20.0f, "50");
+				textAtFreqAndDb(args, 100.0f, -20.0f, "100");
+				textAtFreqAndDb(args, 500.0f, -20.0f, "500");
+				textAtFreqAndDb(args, 1000.0f, -20.0f, "1k");
+				textAtFreqAndDb(args, 5000.0f, -20.0f, "5k");
+				textAtFreqAndDb(args, 10000.0f, -20.0f, "10k");
+				// dB
+				if (!hideDb) {
+					nvgTextAlign(args.vg, NVG_ALIGN_LEFT);
+					textAtFreqAndDb(args, 22.0f, -12.0f, "-12");
+					textAtFreqAndDb(args, 22.0f, -6.0f, "-6");
+					textAtFreqAndDb(args, 22.0f, 0.0f, "0 dB");
+					textAtFreqAndDb(args, 22.0f, 6.0f, "+6");
+					textAtFreqAndDb(args, 22.0f, 12.0f, "+12");
+				}
+			}
+		}
+	};
+	
 	float stepLogFreqs[numDrawSteps + 4 + 1];// 4 for cursors, 1 since will loop with "<= numDrawSteps"
 	simd::float_4 stepDbs[numDrawSteps + 4 + 1];// 4 for cursors, 1 since will loop with "<= numDrawSteps"
+	static const int numGridSteps4 = (numDrawSteps + 1 + 3) & ~0x3;// grid freqs (all but the cursors) rounded up to a multiple of 4
 	
 	// user must set up
 	Param *trackParamSrc = NULL;
@@ -504,11 +592,24 @@ struct EqCurveAndGrid : LightWidget {// TransparentWidget {
 	bool *bandParamsCvConnected;
 	float *drawBuf;// store log magnitude only in first half, log freq in second half
 	int *drawBufSize;
+	PackedBytes4 *miscSettings3Src;
+	float *trackSpecs;// multi-track spectrum, DRAW_BUF_N_2 log magnitudes per track
+	float *trackSpecsX;// log freqs of trackSpecs
+	int *trackSpecsSize;// [24]
+	int8_t *trackLabelColorsSrc;
 	int* lastMovedKnobIdSrc;
 	time_t* lastMovedKnobTimeSrc;
 	
 	// internal
+	FramebufferWidget* gridFb;
+	FramebufferWidget* gridTextFb;// drawn over the spectrum, so separate from gridFb
+	GridTextLayer* gridText;
 	QuattroBiQuadCoeff drawEq;
+	float gridSampleRate = 0.0f;// sample rate of gridZs, 0 when not calculated
+	float gridZs[4 * numGridSteps4];// z^-1 and z^-2 at the grid freqs, see QuattroBiQuadCoeff::getFrequencyResponse()
+	float gridDbs[4][numGridSteps4];// gain (dB) of each band at the grid freqs
+	simd::float_4 gridCoeffs[5];// drawEq coefficients of gridDbs, see QuattroBiQuadCoeff::getCoefficients()
+	simd::float_4 gridLogFreqCursors;// cursors in stepLogFreqs[]
 	std::shared_ptr<Font> font;
 	float sampleRate;// use only in scope of it being set in draw()
 	int currTrk;// use only in scope of it being set in draw()
@@ -517,6 +618,22 @@ struct EqCurveAndGrid : LightWidget {// TransparentWidget {
 	EqCurveAndGrid() {
 		box.size = Vec(eqCurveWidth, mm2px(60.605f));	
 		font = APP->window->loadFont(asset::plugin(pluginInstance, "res/fonts/RobotoCondensed-Regular.ttf"));
+		
+		// children so that they are stepped, but drawn explicitly in draw() to interleave them with the dynamic layers
+		gridFb = new FramebufferWidget;
+		gridFb->box.size = box.size;
+		GridLayer* grid = new GridLayer;
+		grid->box.size = box.size;
+		gridFb->addChild(grid);
+		addChild(gridFb);
+		
+		gridTextFb = new FramebufferWidget;
+		gridTextFb->box.size = box.size;
+		gridText = new GridTextLayer;
+		gridText->box.size = box.size;
+		gridText->font = font;
+		gridTextFb->addChild(gridText);
+		addChild(gridTextFb);
 	}
 	
 	
@@ -524,7 +641,7 @@ struct EqCurveAndGrid : LightWidget {// TransparentWidget {
 		nvgSave(args.vg);
 		
 		// grid
-		drawGrid(args);
+		gridFb->draw(args);
 		
 		if (trackParamSrc != NULL) {
 			currTrk = (int)(trackParamSrc->getValue() + 0.5f);
@@ -533,13 +650,20 @@ struct EqCurveAndGrid : LightWidget {// TransparentWidget {
 			nvgScissor(args.vg, 0, 0, box.size.x, box.size.y);
 			
 			// spectrum
+			if (miscSettings3Src->cc4[2] != 0 && (miscSettingsSrc->cc4[1] & SPEC_MASK_ON) != 0) {
+				drawTrackSpectra(args);
+			}
 			if (*drawBufSize > 0) {
 				drawSpectrum(args);
 			}
 
 			bool hideEqCurves = miscSettings2Src->cc4[2] != 0 && (!trackEqsSrc[currTrk].getTrackActive() || globalBypassParamSrc->getValue() >= 0.5f);
 
-			drawGridtext(args, hideEqCurves);
+			if (gridText->hideDb != hideEqCurves) {
+				gridText->hideDb = hideEqCurves;
+				gridTextFb->dirty = true;
+			}
+			gridTextFb->draw(args);
 			
 			// EQ curves
 			if (!hideEqCurves) {
@@ -554,87 +678,6 @@ struct EqCurveAndGrid : LightWidget {// TransparentWidget {
 	}
 	
 	
-	// grid lines
-	void vertLineAtFreq(const DrawArgs &args, float freq) {
-		float logFreq = std::log10(freq);
-		float lineX = math::rescale(logFreq, minLogFreq, maxLogFreq, 0.0f, box.size.x);
-		nvgMoveTo(args.vg, lineX, 0.0f);
-		nvgLineTo(args.vg, lineX, box.size.y);
-	}
-	void horzLineAtDb(const DrawArgs &args, float dB) {
-		float lineY = math::rescale(dB, minDb, maxDb, box.size.y, 0.0f);
-		nvgMoveTo(args.vg, 0.0f, lineY);
-		nvgLineTo(args.vg, box.size.x, lineY);
-	}
-	void drawGrid(const DrawArgs &args) {
-		NVGcolor lineCol = nvgRGB(0x37, 0x37, 0x37);
-		NVGcolor screenCol = nvgRGB(38, 38, 38);
-		nvgStrokeColor(args.vg, lineCol);
-		nvgStrokeWidth(args.vg, 0.7f);
-		
-		// vertical lines
-		NVGpaint grad = nvgLinearGradient(args.vg, 0.0f, box.size.y * 34.0f / 40.0f, 0.0f, box.size.y, lineCol, screenCol);
-		nvgBeginPath(args.vg);
-		vertLineAtFreq(args, 30.0f);
-		vertLineAtFreq(args, 40.0f);
-		vertLineAtFreq(args, 50.0f);
-		for (int i = 1; i <= 5; i++) {
-			vertLineAtFreq(args, 100.0f * (float)i);
-			vertLineAtFreq(args, 1000.0f * (float)i);
-		}
-		vertLineAtFreq(args, 10000.0f);
-		vertLineAtFreq(args, 20000.0f);
-		nvgStrokePaint(args.vg, grad);
-		nvgStroke(args.vg);
-		
-		// horizontal lines
-		nvgBeginPath(args.vg);
-		horzLineAtDb(args, 20.0f);
-		horzLineAtDb(args, 12.0f);
-		horzLineAtDb(args, 6.0f);
-		horzLineAtDb(args, 0.0f);
-		horzLineAtDb(args, -6.0f);
-		horzLineAtDb(args, -12.0f);
-		//nvgRect(args.vg, 0.0f, 0.0f, box.size.x, box.size.y);
-		nvgStroke(args.vg);	
-	}
-	
-	
-	// text labels in grid lines
-	void textAtFreqAndDb(const DrawArgs &args, float freq, float dB, std::string text) {
-		float logFreq = std::log10(freq);
-		float textX = math::rescale(logFreq, minLogFreq, maxLogFreq, 0.0f, box.size.x);
-		float textY = math::rescale(dB, minDb, maxDb, box.size.y, 0.0f);
-		nvgText(args.vg, textX, textY - 3.0f, text.c_str(), NULL);
-	}
-	void drawGridtext(const DrawArgs &args, bool hideDb) {
-		// text labels
-		if (font->handle >= 0) {
-			nvgFillColor(args.vg, nvgRGB(0x97, 0x97, 0x97));
-			nvgFontFaceId(args.vg, font->handle);
-			nvgTextLetterSpacing(args.vg, 0.0);
-			nvgFontSize(args.vg, 9.0f);
-			nvgTextAlign(args.vg, NVG_ALIGN_CENTER);
-			// frequency
-			textAtFreqAndDb(args, 50.0f, -20.0f, "50");
-			textAtFreqAndDb(args, 100.0f, -20.0f, "100");
-			textAtFreqAndDb(args, 500.0f, -20.0f, "500");
-			textAtFreqAndDb(args, 1000.0f, -20.0f, "1k");
-			textAtFreqAndDb(args, 5000.0f, -20.0f, "5k");
-			textAtFreqAndDb(args, 10000.0f, -20.0f, "10k");
-			// dB
-			if (!hideDb) {
-				nvgTextAlign(args.vg, NVG_ALIGN_LEFT);
-				textAtFreqAndDb(args, 22.0f, -12.0f, "-12");
-				textAtFreqAndDb(args, 22.0f, -6.0f, "-6");
-				textAtFreqAndDb(args, 22.0f, 0.0f, "0 dB");
-				textAtFreqAndDb(args, 22.0f, 6.0f, "+6");
-				textAtFreqAndDb(args, 22.0f, 12.0f, "+12");
-			}
-		}
-	}
-	
-	
 	// spectrum
 	void drawSpectrum(const DrawArgs &args) {
 		nvgLineCap(args.vg, NVG_ROUND);
@@ -653,10 +696,10 @@ struct EqCurveAndGrid : LightWidget {// TransparentWidget {
 		float specY = 0.0f;
 		for (int x = 1; x < *drawBufSize; x++) {	
 			float ampl = drawBuf[x];
-			specX = drawBuf[x + FFT_N_2];
+			specX = drawBuf[x + DRAW_BUF_N_2];
 			specY = ampl;
 			if (x == 1) {
-				nvgLineTo(args.vg, -1.0f, box.size.y - specY );// cheat with a specX of 0 since the first freq is just above 20Hz when FFT_N = 2048, bring to -1.0f though as a hack to not show the side stroke
+				nvgLineTo(args.vg, -1.0f, box.size.y - specY );// cheat with a specX of 0 since the first freq is just above 20Hz when the fft size is 2048, bring to -1.0f though as a hack to not show the side stroke
 			}
 			else {
 				nvgLineTo(args.vg, specX, box.size.y - specY );
@@ -673,6 +716,31 @@ struct EqCurveAndGrid : LightWidget {// TransparentWidget {
 	}
 
 	
+	// multi-track spectrum, the other tracks as lines in their label colors, under the spectrum of the selected track
+	void drawTrackSpectra(const DrawArgs &args) {
+		nvgLineCap(args.vg, NVG_ROUND);
+		nvgLineJoin(args.vg, NVG_ROUND);
+		nvgStrokeWidth(args.vg, 0.7f);
+		for (int t = 0; t < 24; t++) {
+			int size = trackSpecsSize[t];
+			if (t == currTrk || size <= 1) {
+				continue;
+			}
+			NVGcolor color = DISP_COLORS[trackLabelColorsSrc[t]];
+			color.a = 0.5f;
+			nvgStrokeColor(args.vg, color);
+			
+			float* trackSpec = &trackSpecs[t * DRAW_BUF_N_2];
+			nvgBeginPath(args.vg);
+			nvgMoveTo(args.vg, -1.0f, box.size.y - trackSpec[1]);// same left side cheating as drawSpectrum()
+			for (int x = 2; x < size; x++) {
+				nvgLineTo(args.vg, trackSpecsX[x], box.size.y - trackSpec[x]);
+			}
+			nvgStroke(args.vg);
+		}
+	}
+
+	
 	// eq curves
 	void calcCurveData() {
 		// contract: populate stepLogFreqs[], stepDbs[]
@@ -692,20 +760,54 @@ struct EqCurveAndGrid : LightWidget {// TransparentWidget {
 			drawEq.setParameters(b, trackEqsSrc[currTrk].getBandType(b), normalizedFreq[b], linearGain, bandParamsWithCvs[2][b]);
 		}
 		
-		// fill freq response curve data
+		// only recalculate the curves of bands whose coefficients changed, the grid freqs are cached for the sample rate
 		float delLogX = (maxLogFreq - minLogFreq) / ((float)numDrawSteps);
+		simd::float_4 coeffs[5];
+		drawEq.getCoefficients(coeffs);
+		int dirtyBands = 0;
+		if (gridSampleRate != sampleRate) {
+			for (int x = 0; x < numGridSteps4; x++) {
+				float s = 2 * float(M_PI) * std::pow(10.0f, minLogFreq + delLogX * (float)x) / sampleRate;// normalized angular frequency, see getFrequencyResponse()
+				gridZs[x] = std::cos(-s);
+				gridZs[numGridSteps4 + x] = std::sin(-s);
+				gridZs[2 * numGridSteps4 + x] = std::cos(-2 * s);
+				gridZs[3 * numGridSteps4 + x] = std::sin(-2 * s);
+			}
+			gridSampleRate = sampleRate;
+			dirtyBands = 0xF;
+		}
+		else {
+			for (int k = 0; k < 5; k++) {
+				dirtyBands |= (~movemask(coeffs[k] == gridCoeffs[k]) & 0xF);
+			}
+			if (dirtyBands == 0 && movemask(logFreqCursors == gridLogFreqCursors) == 0xF) {
+				return;// stepLogFreqs[] and stepDbs[] are still valid
+			}
+		}
+		for (int b = 0; b < 4; b++) {
+			if ((dirtyBands & (1 << b)) != 0) {
+				drawEq.getFrequencyResponse(b, gridDbs[b], gridZs, numGridSteps4);
+			}
+		}
+		for (int k = 0; k < 5; k++) {
+			gridCoeffs[k] = coeffs[k];
+		}
+		gridLogFreqCursors = logFreqCursors;
+		
+		// fill freq response curve data
 		int c = 0;// index into logFreqCursors (which are sorted)
 		for (int x = 0, i = 0; x <= numDrawSteps; x++, i++) {
 			float logFreqX = minLogFreq + delLogX * (float)x;
 			if ( (c < 4) && (logFreqCursors[c] < logFreqX) ) {
 				stepLogFreqs[i] = logFreqCursors[c];
+				stepDbs[i] = drawEq.getFrequencyResponse(std::pow(10.0f, stepLogFreqs[i]) / sampleRate);
 				c++;
 				x--;
 			}
 			else {
 				stepLogFreqs[i] = logFreqX;
+				stepDbs[i] = simd::float_4(gridDbs[0][x], gridDbs[1][x], gridDbs[2][x], gridDbs[3][x]);
 			}
-			stepDbs[i] = drawEq.getFrequencyResponse(std::pow(10.0f, stepLogFreqs[i]) / sampleRate);
 		}
 	}
 	void drawAllEqCurves(const DrawArgs &args) {
@@ -852,7 +954,7 @@ struct TrackKnob : MmBigKnobWhite {
 	
 	void onChange(const event::Change& e) override {
 		if (updateTrackLabelRequestSrc) {
-			*updateTrackLabelRequestSrc = 1;
+			raiseTrackLabelRequest(updateTrackLabelRequestSrc, 1);
 		}
 		MmBigKnobWhite::onChange(e);
 	}
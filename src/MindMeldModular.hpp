@@ -225,6 +225,29 @@ struct PolyStereoItem : MenuItem {
 
 // General functions
 
+// tan(pi * x) for 0 <= x < 0.5, relative error below 1e-6
+// [5/4] Pade approximant on [0, pi/4], and tan(pi * x) = 1 / tan(pi * (0.5 - x)) above 0.25 (0.5 - x is exact there)
+inline simd::float_4 tanPiFast(simd::float_4 x) {
+	simd::float_4 upper = x > 0.25f;
+	simd::float_4 r = float(M_PI) * simd::ifelse(upper, 0.5f - x, x);
+	simd::float_4 r2 = r * r;
+	simd::float_4 num = r * (945.0f + r2 * (-105.0f + r2));
+	simd::float_4 den = 945.0f + r2 * (-420.0f + r2 * 15.0f);
+	return simd::ifelse(upper, den / num, num / den);
+}
+
+// log2(x) for x >= 0 (0 and denormals give about -127), absolute error below 2e-6
+// exponent from the float bits, and log2(m) = 2 / ln(2) * atanh((m - 1) / (m + 1)) for the mantissa m in [1, 2) (5 terms of the series)
+inline simd::float_4 log2Fast(simd::float_4 x) {
+	__m128i bits = _mm_castps_si128(x.v);
+	simd::float_4 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+	simd::float_4 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+	simd::float_4 t = (m - 1.0f) / (m + 1.0f);
+	simd::float_4 t2 = t * t;
+	simd::float_4 p = 1.0f + t2 * (1.0f / 3.0f + t2 * (1.0f / 5.0f + t2 * (1.0f / 7.0f + t2 * (1.0f / 9.0f))));
+	return e + t * p * (2.0f / float(M_LN2));
+}
+
 // sort the 4 floats in a float_4 in ascending order starting with index 0
 // adapted from https://stackoverflow.com/questions/6145364/sort-4-number-with-few-comparisons
 inline simd::float_4 sortFloat4(simd::float_4 in) {
@@ -327,6 +350,20 @@ static inline void applyStereoWidth(float width, float* left, float* right) {
 	*right = rightSig;
 }
 
+static inline void sumPolyStereo(float* voltages, int channels, float* left, float* right) {
+	// polyStereo: odd channels into left and even channels into right (1-indexed), 
+	//   channels at or above the channel count are masked out instead of assuming they are 0V
+	simd::float_4 numChannels = (float)channels;
+	simd::float_4 channelIndex = simd::float_4(0.0f, 1.0f, 2.0f, 3.0f);
+	simd::float_4 sum = 0.0f;// L R L R
+	for (int c = 0; c < 16; c += 4) {
+		sum += simd::float_4::load(&voltages[c]) & ((channelIndex + (float)c) < numChannels);
+	}
+	sum += _mm_movehl_ps(sum.v, sum.v);
+	*left = sum[0];
+	*right = sum[1];
+}
+
 static inline float clamp20V(float in) {// meant to catch invalid values like -inf, +inf, strong overvoltage only.
 	//return in;
 	if (in >= -20.0f && in <= 20.0f) {
@@ -334,3 +371,6 @@ static inline float clamp20V(float in) {// meant to catch invalid values like -i
 	}
 	return in > 20.0f ? 20.0f : -20.0f;
 }
+static inline simd::float_4 clamp20V(simd::float_4 in) {// same as above on 4 values (NaN also gives -20.0f)
+	return simd::fmin(simd::fmax(in, -20.0f), 20.0f);
+}
@@ -94,12 +94,18 @@ struct MixMaster : Module {
 	int32_t trackMoveInAuxRequest;// 0 when nothing to do, {dest,src} packed when a move is requested
 	int8_t trackOrGroupResetInAux;// -1 when nothing to do, 0 to N_TRK-1 for track reset, N_TRK to N_TRK+N_GRP-1 for group reset 
 	SlewLimiterSingle muteTrackWhenSoloAuxRetSlewer;
+	MixerTrackSimd trackSimd;// post-fader stage of the tracks, 4 tracks per float_4
+	MixerTrackFilterBank trackFilters;// HPF/LPF of the tracks, 2 stereo tracks per float_4
 
 	// No need to save, no reset
 	RefreshCounter refresh;	
 	bool auxExpanderPresent = false;// can't be local to process() since widget must know in order to properly draw border
 	float trackTaps[N_TRK * 2 * 4];// room for 4 taps for each of the 16 (8) stereo tracks. Trk0-tap0, Trk1-tap0 ... Trk15-tap0,  Trk0-tap1
 	float trackInsertOuts[N_TRK * 2];// room for 16 (8) stereo track insert outs
+	float trackInsertIns[N_TRK * 2];// room for 16 (8) stereo track insert inputs
+	uint32_t activeTrackMask = 0;// bit t set when track t has its input connected
+	int activeTracks[N_TRK];// indexes of the tracks in activeTrackMask, only those are processed per sample
+	int numActiveTracks = 0;
 	float groupTaps[N_GRP * 2 * 4];// room for 4 taps for each of the 4 stereo groups
 	float groupInsertOuts[N_GRP * 2];// room for 4 (2) stereo group insert outs
 	float auxTaps[4 * 2 * 4];// room for 4 taps for each of the 4 stereo aux
@@ -232,8 +238,10 @@ struct MixMaster : Module {
 		gInfo.construct(&params[0], values20);
 		trackLabels[4 * (N_TRK + N_GRP)] = 0;
 		for (int i = 0; i < N_TRK; i++) {
-			tracks[i].construct(i, &gInfo, &inputs[0], &params[0], &(trackLabels[4 * i]), &trackTaps[i << 1], groupTaps, &trackInsertOuts[i << 1]);
+			tracks[i].construct(i, &gInfo, &inputs[0], &params[0], &(trackLabels[4 * i]), &trackTaps[i << 1], groupTaps, &trackInsertOuts[i << 1], &trackInsertIns[i << 1]);
 		}
+		trackSimd.construct(&gInfo, tracks, trackTaps, groupTaps);
+		trackFilters.construct(&gInfo, tracks, trackTaps);
 		for (int i = 0; i < N_GRP; i++) {
 			groups[i].construct(i, &gInfo, &inputs[0], &params[0], &(trackLabels[4 * (N_TRK + i)]), &groupTaps[i << 1], &groupInsertOuts[i << 1]);
 		}
@@ -244,7 +252,7 @@ struct MixMaster : Module {
 		muteTrackWhenSoloAuxRetSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second 
 		onReset();
 
-		sendToMessageBus();// register by just writing data
+		sendToMessageBus();// register by just writing data (ignored by the bus while id is still -1, the widget sends again)
 	}
   
 	~MixMaster() {
@@ -273,6 +281,8 @@ struct MixMaster : Module {
 		refreshCounter4 = 0;
 		trackMoveInAuxRequest = 0;
 		trackOrGroupResetInAux = -1;
+		trackSimd.reset();
+		trackFilters.reset();
 		if (recurseNonJson) {
 			gInfo.resetNonJson();
 			for (int i = 0; i < N_TRK; i++) {
@@ -359,6 +369,7 @@ struct MixMaster : Module {
 			groups[grp].onSampleRateChange();
 		}
 		master.onSampleRateChange();
+		trackFilters.onSampleRateChange();
 	}
 	
 
@@ -398,6 +409,7 @@ struct MixMaster : Module {
 			int trackToProcess = (N_TRK == 16 ? sixteenCount : (sixteenCount & 0x7));
 			gInfo.updateSoloBit(trackToProcess);
 			tracks[trackToProcess].updateSlowValues();// a track is updated once every 16 passes in input proceesing
+			trackFilters.updateSlowValues(trackToProcess);
 			// Groups
 			if ( (sixteenCount & 0x3) == 0) {// a group is updated once every 16 passes in input proceesing
 				int groupToProcess = sixteenCount >> (4 - N_GRP / 2);
@@ -416,6 +428,15 @@ struct MixMaster : Module {
 			}
 			
 			processMuteSoloCvTriggers();
+			
+			// Active tracks
+			UpdateActiveTracks();
+			for (int trk = 0; trk < N_TRK; trk++) {
+				if ((activeTrackMask & (1 << trk)) == 0) {
+					tracks[trk].processEcoControls(RefreshCounter::userInputsStepSkipMask + 1);
+					tracks[trk].processUnused();
+				}
+			}
 		}// userInputs refresh
 		
 		
@@ -434,10 +455,24 @@ struct MixMaster : Module {
 		// GlobalInfo
 		gInfo.process();
 		
-		// Tracks
-		for (int trk = 0; trk < N_TRK; trk++) {
-			tracks[trk].process(mix, ecoCode == 0);// stagger 1
+		// Insert ins (fills trackInsertIns)
+		GetInsertTrackIns(0);// 1-8
+		if (N_TRK == 16) {
+			GetInsertTrackIns(8);// 9-16
+		}
+		
+		// Tracks (only the active ones, the others are updated with the user inputs above)
+		for (int i = 0; i < numActiveTracks; i++) {
+			tracks[activeTracks[i]].processPreFilter(ecoCode == 0);// stagger 1
+		}
+		trackFilters.process();
+		for (int i = 0; i < numActiveTracks; i++) {
+			MixerTrack* track = &tracks[activeTracks[i]];
+			if (track->oldInUse) {
+				track->processPostFilter(ecoCode == 0);// stagger 1
+			}
 		}
+		trackSimd.process(mix, ecoCode == 0);// stagger 1
 		// Aux return when group
 		if (auxExpanderPresent) {
 			muteAuxSendWhenReturnGrouped = 0;
@@ -727,6 +762,40 @@ struct MixMaster : Module {
 	}
 	
 	
+	void UpdateActiveTracks() {// list rebuilt only when the track input connections change
+		uint32_t mask = 0;
+		for (int trk = 0; trk < N_TRK; trk++) {
+			if (inputs[TRACK_SIGNAL_INPUTS + 2 * trk].isConnected()) {
+				mask |= (1 << trk);
+			}
+		}
+		if (mask != activeTrackMask) {
+			activeTrackMask = mask;
+			numActiveTracks = 0;
+			for (int trk = 0; trk < N_TRK; trk++) {
+				if ((mask & (1 << trk)) != 0) {
+					activeTracks[numActiveTracks++] = trk;
+				}
+			}
+		}
+	}
+	
+	
+	void GetInsertTrackIns(const int base) {// base is 0 or 8
+		int ini = base >> 3;
+		if (inputs[INSERT_TRACK_INPUTS + ini].isConnected()) {
+			// all 16 channels, with the ones at or above the channel count masked to 0V as in sumPolyStereo()
+			float* voltages = inputs[INSERT_TRACK_INPUTS + ini].getVoltages();
+			simd::float_4 numChannels = (float)inputs[INSERT_TRACK_INPUTS + ini].getChannels();
+			simd::float_4 channelIndex = simd::float_4(0.0f, 1.0f, 2.0f, 3.0f);
+			for (int i = 0; i < 16; i += 4) {
+				simd::float_4 inUse = (channelIndex + (float)i) < numChannels;
+				clamp20V(simd::float_4::load(&voltages[i]) & inUse).store(&trackInsertIns[(base << 1) + i]);
+			}
+		}
+	}
+	
+	
 	void SetInsertTrackOuts(const int base) {// base is 0 or 8
 		int outi = base >> 3;
 		if (outputs[INSERT_TRACK_OUTPUTS + outi].isConnected()) {
@@ -878,6 +947,13 @@ struct MixMasterWidget : ModuleWidget {
         setPanel(APP->window->loadSvg(asset::plugin(pluginInstance, "res/dark/mixmaster.svg")));
 		panelBorder = findBorder(panel);		
 		
+		// VU meter bridge, draws the track-like VUs below in a few batched fills
+		VuMeterBridge *vuBridge = NULL;
+		if (module) {
+			addChild(vuBridge = createWidget<VuMeterBridge>(Vec(0, 0)));
+			vuBridge->box.size = box.size;
+		}
+		
 		// Inserts and CVs
 		static const float xIns = 13.8;
 		// Insert outputs
@@ -953,6 +1029,7 @@ struct MixMasterWidget : ModuleWidget {
 				newVU->colorThemeGlobal = &(module->gInfo.colorAndCloak.cc4[vuColorGlobal]);
 				newVU->colorThemeLocal = &(module->tracks[i].vuColorThemeLocal);
 				addChild(newVU);
+				vuBridge->addMeter(newVU);
 				// Fade pointers
 				CvAndFadePointerTrack *newFP = createWidgetCentered<CvAndFadePointerTrack>(mm2px(Vec(xTrck1 - 2.95 + 12.7 * i, 81.2)));
 				newFP->srcParam = &(module->params[TMixMaster::TRACK_FADER_PARAMS + i]);
@@ -1067,6 +1144,7 @@ struct MixMasterWidget : ModuleWidget {
 				newVU->colorThemeGlobal = &(module->gInfo.colorAndCloak.cc4[vuColorGlobal]);
 				newVU->colorThemeLocal = &(module->groups[i].vuColorThemeLocal);
 				addChild(newVU);
+				vuBridge->addMeter(newVU);
 				// Fade pointers
 				CvAndFadePointerGroup *newFP = createWidgetCentered<CvAndFadePointerGroup>(mm2px(Vec(xGrp1 - 2.95 + 12.7 * i, 81.2)));
 				newFP->srcParam = &(module->params[TMixMaster::GROUP_FADER_PARAMS + i]);
@@ -1123,6 +1201,7 @@ struct MixMasterWidget : ModuleWidget {
 			masterDisplay->colorAndCloak = &(module->gInfo.colorAndCloak);
 			masterDisplay->idSrc = &(module->id);
 			masterDisplay->masterFaderScalesSendsSrc = &(module->gInfo.masterFaderScalesSends);
+			masterDisplay->loudness = &(module->master.loudness);
 		}
 		
 		// Master fader
@@ -1183,6 +1262,13 @@ struct MixMasterJrWidget : ModuleWidget {
         setPanel(APP->window->loadSvg(asset::plugin(pluginInstance, "res/dark/mixmaster-jr.svg")));
 		panelBorder = findBorder(panel);		
 		
+		// VU meter bridge, draws the track-like VUs below in a few batched fills
+		VuMeterBridge *vuBridge = NULL;
+		if (module) {
+			addChild(vuBridge = createWidget<VuMeterBridge>(Vec(0, 0)));
+			vuBridge->box.size = box.size;
+		}
+		
 		// Inserts and CVs
 		static const float xIns = 13.8;
 		// Fade CV output
@@ -1257,6 +1343,7 @@ struct MixMasterJrWidget : ModuleWidget {
 				newVU->colorThemeGlobal = &(module->gInfo.colorAndCloak.cc4[vuColorGlobal]);
 				newVU->colorThemeLocal = &(module->tracks[i].vuColorThemeLocal);
 				addChild(newVU);
+				vuBridge->addMeter(newVU);
 				// Fade pointers
 				CvAndFadePointerTrack *newFP = createWidgetCentered<CvAndFadePointerTrack>(mm2px(Vec(xTrck1 - 2.95 + 12.7 * i, 81.2)));
 				newFP->srcParam = &(module->params[TMixMaster::TRACK_FADER_PARAMS + i]);
@@ -1366,6 +1453,7 @@ struct MixMasterJrWidget : ModuleWidget {
 				newVU->colorThemeGlobal = &(module->gInfo.colorAndCloak.cc4[vuColorGlobal]);
 				newVU->colorThemeLocal = &(module->groups[i].vuColorThemeLocal);
 				addChild(newVU);
+				vuBridge->addMeter(newVU);
 				// Fade pointers
 				CvAndFadePointerGroup *newFP = createWidgetCentered<CvAndFadePointerGroup>(mm2px(Vec(xGrp1 - 2.95 + 12.7 * i, 81.2)));
 				newFP->srcParam = &(module->params[TMixMaster::GROUP_FADER_PARAMS + i]);
@@ -1422,6 +1510,7 @@ struct MixMasterJrWidget : ModuleWidget {
 			masterDisplay->colorAndCloak = &(module->gInfo.colorAndCloak);
 			masterDisplay->idSrc = &(module->id);
 			masterDisplay->masterFaderScalesSendsSrc = &(module->gInfo.masterFaderScalesSends);
+			masterDisplay->loudness = &(module->master.loudness);
 		}
 		
 		// Master fader
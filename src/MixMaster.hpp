@@ -429,6 +429,7 @@ struct MixerMaster {
 	FirstOrderStereoFilter dcBlockerStereo;// 6dB/oct
 	public:
 	VuMeterAllDual vu;// use mix[0..1]
+	LoudnessMeter loudness;// LUFS and true-peak of the master output (post clipping)
 	float fadeGain; // target of this gain is the value of the mute/fade button's param (i.e. 0.0f or 1.0f)
 	float target;// used detect button press (needed to reset fadeGainXr and VUs)
 	float fadeGainX;// absolute X value of fade, between 0.0f and 1.0f (for symmetrical fade)
@@ -480,6 +481,7 @@ struct MixerMaster {
 		chainGainAndMuteSlewers.reset();
 		setupDcBlocker();
 		vu.reset();
+		loudness.setSampleRate(1.0f / gInfo->sampleTime);
 		fadeGain = calcFadeGain();
 		target = fadeGain;
 		fadeGainX = fadeGain;
@@ -578,6 +580,7 @@ struct MixerMaster {
 	
 	void onSampleRateChange() {
 		setupDcBlocker();
+		loudness.setSampleRate(1.0f / gInfo->sampleTime);
 	}
 	
 	
@@ -649,7 +652,7 @@ struct MixerMaster {
 				if (isFadeMode()) {
 					float deltaX = (gInfo->sampleTime / fadeRate) * (1 + (gInfo->ecoMode & 0x3));// last value is sub refresh
 					fadeGain = updateFadeGain(fadeGain, target, &fadeGainX, &fadeGainXr, deltaX, fadeProfile, gInfo->symmetricalFade);
-					fadeGainScaled = std::pow(fadeGain, GlobalConst::masterFaderScalingExponent);
+					fadeGainScaled = powInt(fadeGain, GlobalConst::masterFaderScalingExponent);
 				}
 				else {// we are in mute mode
 					fadeGain = target;
@@ -746,6 +749,9 @@ struct MixerMaster {
 		// Clipping (post VU, so that we can see true range)
 		mix[0] = clip(mix[0]);
 		mix[1] = clip(mix[1]);
+		
+		// Loudness (post clipping, always on)
+		loudness.process(mix);
 	}		
 };// struct MixerMaster
 
@@ -1118,7 +1124,7 @@ struct MixerGroup {
 				if (isFadeMode()) {
 					float deltaX = (gInfo->sampleTime / *fadeRate) * (1 + (gInfo->ecoMode & 0x3));// last value is sub refresh
 					fadeGain = updateFadeGain(fadeGain, target, &fadeGainX, &fadeGainXr, deltaX, fadeProfile, gInfo->symmetricalFade);
-					fadeGainScaled = std::pow(fadeGain, GlobalConst::trkAndGrpFaderScalingExponent);
+					fadeGainScaled = powInt(fadeGain, GlobalConst::trkAndGrpFaderScalingExponent);
 				}
 				else {// we are in mute mode
 					fadeGain = target;
@@ -1230,6 +1236,8 @@ struct MixerGroup {
 //*****************************************************************************
 
 
+struct MixerTrackSimd;
+
 struct MixerTrack {
 	// Constants
 	// none
@@ -1259,12 +1267,8 @@ struct MixerTrack {
 	float inGain;
 	simd::float_4 panMatrix;
 	simd::float_4 gainMatrix;	
-	TSlewLimiterSingle<simd::float_4> gainMatrixSlewers;
 	SlewLimiterSingle inGainSlewer;
 	SlewLimiterSingle stereoWidthSlewer;
-	SlewLimiterSingle muteSoloGainSlewer;
-	ButterworthThirdOrder hpFilter[2];// 18dB/oct
-	ButterworthSecondOrder lpFilter[2];// 12db/oct
 	float lastHpfCutoff;
 	float lastLpfCutoff;
 	float oldPan;
@@ -1303,15 +1307,17 @@ struct MixerTrack {
 	float *taps;// [0],[1]: pre-insert L R; [32][33]: pre-fader L R, [64][65]: post-fader L R, [96][97]: post-mute-solo L R
 	float* groupTaps;// [0..1] tap 0 of group 1, [1..2] tap 0 of group 2, etc.
 	float *insertOuts;// [0][1]: insert outs for this track
+	float *insertIns;// [0][1]: insert inputs for this track, clamped, filled in bulk by the owner when the insert input is connected
 	bool oldInUse = true;
 	float fader = 0.0f;// this is set only in process() when eco, and also used only when eco in another section of this method
+	MixerTrackSimd *trackSimd;// post-fader stage, set by MixerTrackSimd::construct()
 
 
 	float calcFadeGain() {return paMute->getValue() >= 0.5f ? 0.0f : 1.0f;}
 	bool isFadeMode() {return *fadeRate >= GlobalConst::minFadeRate;}
 
 
-	void construct(int _trackNum, GlobalInfo *_gInfo, Input *_inputs, Param *_params, char* _trackName, float* _taps, float* _groupTaps, float* _insertOuts) {
+	void construct(int _trackNum, GlobalInfo *_gInfo, Input *_inputs, Param *_params, char* _trackName, float* _taps, float* _groupTaps, float* _insertOuts, float* _insertIns) {
 		trackNum = _trackNum;
 		ids = "id_t" + std::to_string(trackNum) + "_";
 		gInfo = _gInfo;
@@ -1332,15 +1338,10 @@ struct MixerTrack {
 		taps = _taps;
 		groupTaps = _groupTaps;
 		insertOuts = _insertOuts;
+		insertIns = _insertIns;
 		fadeRate = &(_gInfo->fadeRates[trackNum]);
-		gainMatrixSlewers.setRiseFall(simd::float_4(GlobalConst::antipopSlewSlow)); // slew rate is in input-units per second (ex: V/s)
 		inGainSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second (ex: V/s)
 		stereoWidthSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second (ex: V/s)
-		muteSoloGainSlewer.setRiseFall(GlobalConst::antipopSlewFast); // slew rate is in input-units per second (ex: V/s)
-		for (int i = 0; i < 2; i++) {
-			hpFilter[i].setParameters(true, 0.1f);
-			lpFilter[i].setParameters(false, 0.4f);
-		}
 	}
 
 
@@ -1368,18 +1369,12 @@ struct MixerTrack {
 		inGain = 0.0f;
 		panMatrix = 0.0f;
 		gainMatrix = 0.0f;
-		gainMatrixSlewers.reset();
 		inGainSlewer.reset();
 		stereoWidthSlewer.reset();
-		muteSoloGainSlewer.reset(); 
 		setHPFCutoffFreq(paHpfCutoff->getValue());// off
 		setLPFCutoffFreq(paLpfCutoff->getValue());// off
 		// lastHpfCutoff; automatically set in setHPFCutoffFreq()
 		// lastLpfCutoff; automatically set in setLPFCutoffFreq()
-		for (int i = 0; i < 2; i++) {
-			hpFilter[i].reset();
-			lpFilter[i].reset();
-		}
 		oldPan = -10.0f;
 		oldPanSignature.cc1 = 0xFFFFFFFF;
 		vu.reset();
@@ -1602,18 +1597,12 @@ struct MixerTrack {
 	void setHPFCutoffFreq(float fc) {
 		paHpfCutoff->setValue(fc);
 		lastHpfCutoff = fc;
-		fc *= gInfo->sampleTime;// fc is in normalized freq for rest of method
-		hpFilter[0].setParameters(true, fc);
-		hpFilter[1].setParameters(true, fc);
 	}
 	float getHPFCutoffFreq() {return paHpfCutoff->getValue();}
 	
 	void setLPFCutoffFreq(float fc) {
 		paLpfCutoff->setValue(fc);
 		lastLpfCutoff = fc;
-		fc *= gInfo->sampleTime;// fc is in normalized freq for rest of method
-		lpFilter[0].setParameters(false, fc);
-		lpFilter[1].setParameters(false, fc);
 	}
 	float getLPFCutoffFreq() {return paLpfCutoff->getValue();}
 
@@ -1686,91 +1675,189 @@ struct MixerTrack {
 	}
 	
 
-	void process(float *mix, bool eco) {// track		
-		if (eco) {
-			// calc ** fadeGain, fadeGainX, fadeGainXr, target, fadeGainScaled **
-			float newTarget = calcFadeGain();
-			if (newTarget != target) {
-				fadeGainXr = 0.0f;
-				if (isFadeMode()) {
-					gInfo->fadeOtherLinkedTracks(trackNum, newTarget);
-				}
-				target = newTarget;
-				vu.reset();
+	void sumInputs(float *dest) {// dest[0] and dest[1] get the L and R input sums, before in gain (R is a copy of L when mono)
+		if (stereo) {// either because R is connected, or polyStereo is active and L is a poly cable
+			if (inSig[1].isConnected()) {// if stereo because R connected
+				dest[0] = inSig[0].getVoltageSum();
+				dest[1] = inSig[1].getVoltageSum();
 			}
-			if (fadeGain != target) {
-				if (isFadeMode()) {
-					float deltaX = (gInfo->sampleTime / *fadeRate) * (1 + (gInfo->ecoMode & 0x3));// last value is sub refresh
-					fadeGain = updateFadeGain(fadeGain, target, &fadeGainX, &fadeGainXr, deltaX, fadeProfile, gInfo->symmetricalFade);
-					fadeGainScaled = std::pow(fadeGain, GlobalConst::trkAndGrpFaderScalingExponent);
-				}
-				else {// we are in mute mode
-					fadeGain = target;
-					fadeGainX = target;
-					fadeGainScaled = target;// no pow needed here since 0.0f or 1.0f
-				}
+			else {// here were are in polyStero mode, so take all odd numbered into L, even numbered into R (1-indexed)
+				sumPolyStereo(inSig[0].getVoltages(), inSig[0].getChannels(), &dest[0], &dest[1]);
 			}
-			fadeGainScaledWithSolo = fadeGainScaled * soloGain;
+		}
+		else {
+			dest[0] = inSig[0].getVoltageSum();
+			dest[1] = dest[0];
+		}
+	}
 
-			// calc ** fader, paramWithCV, volCv **
-			fader = paFade->getValue();
-			float volCvVoltage = 1e6;
-			if (inVol->isConnected()) {
-				volCvVoltage = inVol->getVoltage();
-			}
-			else if (inVolTrack1->getChannels() > trackNum) {
-				// poly spread track 1 when sufficient channels in the poly cable
-				volCvVoltage = inVolTrack1->getVoltage(trackNum);
+
+	void processEcoControls(int ecoSteps) {// ecoSteps is the number of samples since the last call
+		// calc ** fadeGain, fadeGainX, fadeGainXr, target, fadeGainScaled **
+		float newTarget = calcFadeGain();
+		if (newTarget != target) {
+			fadeGainXr = 0.0f;
+			if (isFadeMode()) {
+				gInfo->fadeOtherLinkedTracks(trackNum, newTarget);
 			}
-			if (volCvVoltage != 1e6) {
-				volCv = clamp(volCvVoltage * 0.1f, 0.0f, 1.0f);
-				paramWithCV = fader * volCv;
-				if (gInfo->directOutPanStereoMomentCvLinearVol.cc4[3] == 0) {
-					fader = paramWithCV;
-				}	
+			target = newTarget;
+			vu.reset();
+			trackSimd->clearVu(trackNum);
+		}
+		if (fadeGain != target) {
+			if (isFadeMode()) {
+				float deltaX = (gInfo->sampleTime / *fadeRate) * ecoSteps;// ecoSteps is the number of samples since last call
+				fadeGain = updateFadeGain(fadeGain, target, &fadeGainX, &fadeGainXr, deltaX, fadeProfile, gInfo->symmetricalFade);
+				fadeGainScaled = powInt(fadeGain, GlobalConst::trkAndGrpFaderScalingExponent);
 			}
-			else {
-				volCv = 1.0f;
-				paramWithCV = -100.0f;
+			else {// we are in mute mode
+				fadeGain = target;
+				fadeGainX = target;
+				fadeGainScaled = target;// no pow needed here since 0.0f or 1.0f
 			}
+		}
+		fadeGainScaledWithSolo = fadeGainScaled * soloGain;
 
-			// calc ** pan **
-			pan = paPan->getValue();
-			panCvConnected = inPan->isConnected();
+		// calc ** fader, paramWithCV, volCv **
+		fader = paFade->getValue();
+		float volCvVoltage = 1e6;
+		if (inVol->isConnected()) {
+			volCvVoltage = inVol->getVoltage();
+		}
+		else if (inVolTrack1->getChannels() > trackNum) {
+			// poly spread track 1 when sufficient channels in the poly cable
+			volCvVoltage = inVolTrack1->getVoltage(trackNum);
+		}
+		if (volCvVoltage != 1e6) {
+			volCv = clamp(volCvVoltage * 0.1f, 0.0f, 1.0f);
+			paramWithCV = fader * volCv;
+			if (gInfo->directOutPanStereoMomentCvLinearVol.cc4[3] == 0) {
+				fader = paramWithCV;
+			}	
+		}
+		else {
+			volCv = 1.0f;
+			paramWithCV = -100.0f;
+		}
+
+		// calc ** pan **
+		pan = paPan->getValue();
+		panCvConnected = inPan->isConnected();
+		if (panCvConnected) {
+			pan += inPan->getVoltage() * 0.1f * panCvLevel;// CV is a -5V to +5V input
+			pan = clamp(pan, 0.0f, 1.0f);
+		}
+		else {
+			// poly spread track 1 when sufficient channels in the poly cable
+			panCvConnected = (inPanTrack1->getChannels() > trackNum);
 			if (panCvConnected) {
-				pan += inPan->getVoltage() * 0.1f * panCvLevel;// CV is a -5V to +5V input
+				pan += inPanTrack1->getVoltage(trackNum) * 0.1f * panCvLevel;// CV is a -5V to +5V input
 				pan = clamp(pan, 0.0f, 1.0f);
 			}
-			else {
-				// poly spread track 1 when sufficient channels in the poly cable
-				panCvConnected = (inPanTrack1->getChannels() > trackNum);
-				if (panCvConnected) {
-					pan += inPanTrack1->getVoltage(trackNum) * 0.1f * panCvLevel;// CV is a -5V to +5V input
-					pan = clamp(pan, 0.0f, 1.0f);
+		}
+	}
+
+
+	void processUnused() {
+		if (oldInUse) {
+			taps[0] = 0.0f; taps[1] = 0.0f;
+			taps[N_TRK * 2 + 0] = 0.0f; taps[N_TRK * 2 + 1] = 0.0f;
+			taps[N_TRK * 4 + 0] = 0.0f; taps[N_TRK * 4 + 1] = 0.0f;
+			taps[N_TRK * 6 + 0] = 0.0f; taps[N_TRK * 6 + 1] = 0.0f;
+			insertOuts[0] = 0.0f;
+			insertOuts[1] = 0.0f;
+			vu.reset();
+			inGainSlewer.reset();
+			stereoWidthSlewer.reset();
+			oldInUse = false;
+			trackSimd->setInUse(trackNum, false);
+		}
+	}
+
+
+	void processEcoGainMatrix() {
+		// calc ** panMatrix **
+		if (pan != oldPan) {
+			panMatrix = 0.0f;// L, R, RinL, LinR (used for fader-pan block)
+			if (pan == 0.5f) {
+				if (!stereo) panMatrix[3] = 1.0f;
+				else panMatrix[1] = 1.0f;
+				panMatrix[0] = 1.0f;
+			}
+			else {		
+				if (!stereo) {// mono
+					if (gInfo->panLawMono == 3) {
+						// Linear panning law (+6dB boost)
+						panMatrix[3] = pan * 2.0f;
+						panMatrix[0] = 2.0f - panMatrix[3];
+					}
+					else if (gInfo->panLawMono == 0) {
+						// No compensation (+0dB boost)
+						panMatrix[3] = std::min(1.0f, pan * 2.0f);
+						panMatrix[0] = std::min(1.0f, 2.0f - pan * 2.0f);
+					}
+					else if (gInfo->panLawMono == 1) {
+						// Equal power panning law (+3dB boost)
+						sinCosSqrt2(&panMatrix[3], &panMatrix[0], pan * float(M_PI_2));
+					}
+					else {//if (gInfo->panLawMono == 2) {
+						// Compromise (+4.5dB boost)
+						sinCosSqrt2(&panMatrix[3], &panMatrix[0], pan * float(M_PI_2));
+						panMatrix[3] = std::sqrt( std::abs( panMatrix[3] * (pan * 2.0f) ) );
+						panMatrix[0] = std::sqrt( std::abs( panMatrix[0] * (2.0f - pan * 2.0f) ) );
+					}
+				}
+				else {// stereo
+					int stereoPanMode = (gInfo->directOutPanStereoMomentCvLinearVol.cc4[1] < 3 ? gInfo->directOutPanStereoMomentCvLinearVol.cc4[1] : panLawStereo);			
+					if (stereoPanMode == 0) {
+						// Stereo balance linear, (+0 dB), same as mono No compensation
+						panMatrix[1] = std::min(1.0f, pan * 2.0f);
+						panMatrix[0] = std::min(1.0f, 2.0f - pan * 2.0f);
+					}
+					else if (stereoPanMode == 1) {
+						// Stereo balance equal power (+3dB), same as mono Equal power
+						sinCosSqrt2(&panMatrix[1], &panMatrix[0], pan * float(M_PI_2));
+					}
+					else {
+						// True panning, equal power
+						if (pan > 0.5f) {
+							panMatrix[1] = 1.0f;
+							panMatrix[2] = 0.0f;
+							sinCos(&panMatrix[3], &panMatrix[0], (pan - 0.5f) * float(M_PI));
+						}
+						else {// must be < (not <= since = 0.5 is caught at above)
+							sinCos(&panMatrix[1], &panMatrix[2], pan * float(M_PI));
+							panMatrix[0] = 1.0f;
+							panMatrix[3] = 0.0f;
+						}
+					}
 				}
 			}
+			oldPan = pan;
+		}
+		// calc ** gainMatrix **
+		fader = std::pow(fader, GlobalConst::trkAndGrpFaderScalingExponent);// scaling
+		gainMatrix = panMatrix * fader;
+	}
+
+
+	// input and insert stages up to the filters (taps 0 and 1), returns false when the track is not in use
+	bool processPreFilter(bool eco) {// track		
+		if (eco) {
+			processEcoControls(1 + (gInfo->ecoMode & 0x3));
 		}
 
 
 		// optimize unused track
 		if (!inSig[0].isConnected()) {
-			if (oldInUse) {
-				taps[0] = 0.0f; taps[1] = 0.0f;
-				taps[N_TRK * 2 + 0] = 0.0f; taps[N_TRK * 2 + 1] = 0.0f;
-				taps[N_TRK * 4 + 0] = 0.0f; taps[N_TRK * 4 + 1] = 0.0f;
-				taps[N_TRK * 6 + 0] = 0.0f; taps[N_TRK * 6 + 1] = 0.0f;
-				insertOuts[0] = 0.0f;
-				insertOuts[1] = 0.0f;
-				vu.reset();
-				gainMatrixSlewers.reset();
-				inGainSlewer.reset();
-				stereoWidthSlewer.reset();
-				muteSoloGainSlewer.reset();
-				oldInUse = false;
-			}
-			return;
+			processUnused();
+			return false;
+		}
+		if (!oldInUse) {
+			oldInUse = true;
+			trackSimd->setInUse(trackNum, true);
+			setSimdLane();// setInUse(false) zeroed the lane, don't wait for the next eco sample
 		}
-		oldInUse = true;
 			
 		
 		// Tap[0],[1]: pre-insert (inputs with gain adjust and stereo width)
@@ -1779,30 +1866,9 @@ struct MixerTrack {
 		if (inGain != inGainSlewer.out) {
 			inGainSlewer.process(gInfo->sampleTime, inGain);
 		}
-		if (stereo) {// either because R is connected, or polyStereo is active and L is a poly cable
-			if (inSig[1].isConnected()) {// if stereo because R connected
-				taps[0] = inSig[0].getVoltageSum();
-				taps[1] = inSig[1].getVoltageSum();
-			}
-			else {// here were are in polyStero mode, so take all odd numbered into L, even numbered into R (1-indexed)
-				taps[0] = 0.0f;
-				taps[1] = 0.0f;
-				for (int c = 0; c < inSig[0].getChannels(); c++) {
-					if ((c & 0x1) == 0) {// if L channels (odd channels when 1-indexed)
-						taps[0] += inSig[0].getVoltage(c);
-					}
-					else {
-						taps[1] += inSig[0].getVoltage(c);
-					}
-				}
-			}
-			taps[0] = clamp20V(taps[0] * inGainSlewer.out);
-			taps[1] = clamp20V(taps[1] * inGainSlewer.out);
-		}
-		else {
-			taps[0] = clamp20V(inSig[0].getVoltageSum() * inGainSlewer.out);
-			taps[1] = taps[0];
-		}
+		sumInputs(taps);
+		taps[0] = clamp20V(taps[0] * inGainSlewer.out);
+		taps[1] = stereo ? clamp20V(taps[1] * inGainSlewer.out) : taps[0];
 		
 		// Stereo width
 		if (stereoWidth != stereoWidthSlewer.out) {
@@ -1815,170 +1881,502 @@ struct MixerTrack {
 
 		// Tap[32],[33]: pre-fader (inserts and filters)
 		
-		int insertPortIndex = trackNum >> 3;		
-		if (gInfo->filterPos == 1 || (gInfo->filterPos == 2 && filterPos == 1)) {// if filters post insert
+		if (filtersPostInsert()) {
 			// Insert outputs
 			insertOuts[0] = taps[0];
 			insertOuts[1] = stereo ? taps[1] : 0.0f;// don't send to R of insert outs when mono
 			
 			// Insert inputs
-			if (inInsert[insertPortIndex].isConnected()) {
-				taps[N_TRK * 2 + 0] = clamp20V(inInsert[insertPortIndex].getVoltage(((trackNum & 0x7) << 1) + 0));
-				taps[N_TRK * 2 + 1] = stereo ? clamp20V(inInsert[insertPortIndex].getVoltage(((trackNum & 0x7) << 1) + 1)) : taps[N_TRK * 2 + 0];// don't receive from R of insert outs when mono, just normal L into R (need this for aux sends)
-			}
-			else {
+			if (!processInsertInputs()) {
 				taps[N_TRK * 2 + 0] = taps[0];
 				taps[N_TRK * 2 + 1] = taps[1];
 			}
-
-			// Filters
-			// HPF
-			if (getHPFCutoffFreq() >= GlobalConst::minHPFCutoffFreq) {
-				taps[N_TRK * 2 + 0] = hpFilter[0].process(taps[N_TRK * 2 + 0]);
-				taps[N_TRK * 2 + 1] = stereo ? hpFilter[1].process(taps[N_TRK * 2 + 1]) : taps[N_TRK * 2 + 0];
-			}
-			// LPF
-			if (getLPFCutoffFreq() <= GlobalConst::maxLPFCutoffFreq) {
-				taps[N_TRK * 2 + 0] = lpFilter[0].process(taps[N_TRK * 2 + 0]);
-				taps[N_TRK * 2 + 1] = stereo ? lpFilter[1].process(taps[N_TRK * 2 + 1]) : taps[N_TRK * 2 + 0];
-			}
 		}
 		else {// filters before inserts
 			taps[N_TRK * 2 + 0] = taps[0];
 			taps[N_TRK * 2 + 1] = taps[1];
-			// Filters
-			// HPF
-			if (getHPFCutoffFreq() >= GlobalConst::minHPFCutoffFreq) {
-				taps[N_TRK * 2 + 0] = hpFilter[0].process(taps[N_TRK * 2 + 0]);
-				taps[N_TRK * 2 + 1] = stereo ? hpFilter[1].process(taps[N_TRK * 2 + 1]) : taps[N_TRK * 2 + 0];
-			}
-			// LPF
-			if (getLPFCutoffFreq() <= GlobalConst::maxLPFCutoffFreq) {
-				taps[N_TRK * 2 + 0] = lpFilter[0].process(taps[N_TRK * 2 + 0]);
-				taps[N_TRK * 2 + 1] = stereo ? lpFilter[1].process(taps[N_TRK * 2 + 1]) : taps[N_TRK * 2 + 0];
-			}
-			
+		}
+		return true;
+	}
+	
+	
+	bool filtersPostInsert() {
+		return gInfo->filterPos == 1 || (gInfo->filterPos == 2 && filterPos == 1);
+	}
+	
+	
+	bool processInsertInputs() {// returns false when the insert input is not connected
+		if (inInsert[trackNum >> 3].isConnected()) {
+			taps[N_TRK * 2 + 0] = insertIns[0];
+			taps[N_TRK * 2 + 1] = stereo ? insertIns[1] : insertIns[0];// don't receive from R of insert outs when mono, just normal L into R (need this for aux sends)
+			return true;
+		}
+		return false;
+	}
+	
+	
+	// insert stage when filters are before inserts, and eco gain matrix; only call when processPreFilter() returned true
+	void processPostFilter(bool eco) {// track
+		if (!stereo) {
+			taps[N_TRK * 2 + 1] = taps[N_TRK * 2 + 0];
+		}
+		if (!filtersPostInsert()) {
 			// Insert outputs
 			insertOuts[0] = taps[N_TRK * 2 + 0];
 			insertOuts[1] = stereo ? taps[N_TRK * 2 + 1] : 0.0f;// don't send to R of insert outs when mono!
 			
 			// Insert inputs
-			if (inInsert[insertPortIndex].isConnected()) {
-				taps[N_TRK * 2 + 0] = clamp20V(inInsert[insertPortIndex].getVoltage(((trackNum & 0x7) << 1) + 0));
-				taps[N_TRK * 2 + 1] = stereo ? clamp20V(inInsert[insertPortIndex].getVoltage(((trackNum & 0x7) << 1) + 1)) : taps[N_TRK * 2 + 0];// don't receive from R of insert outs when mono, just normal L into R (need this for aux sends)
-			}
-		}// filterPos
-		
-		
-		// Tap[64],[65]: post-fader (pan and fader)
+			processInsertInputs();
+		}
 		
+		// gainMatrix for post-fader (pan and fader)
 		if (eco) {
-			// calc ** panMatrix **
-			if (pan != oldPan) {
-				panMatrix = 0.0f;// L, R, RinL, LinR (used for fader-pan block)
-				if (pan == 0.5f) {
-					if (!stereo) panMatrix[3] = 1.0f;
-					else panMatrix[1] = 1.0f;
-					panMatrix[0] = 1.0f;
-				}
-				else {		
-					if (!stereo) {// mono
-						if (gInfo->panLawMono == 3) {
-							// Linear panning law (+6dB boost)
-							panMatrix[3] = pan * 2.0f;
-							panMatrix[0] = 2.0f - panMatrix[3];
-						}
-						else if (gInfo->panLawMono == 0) {
-							// No compensation (+0dB boost)
-							panMatrix[3] = std::min(1.0f, pan * 2.0f);
-							panMatrix[0] = std::min(1.0f, 2.0f - pan * 2.0f);
-						}
-						else if (gInfo->panLawMono == 1) {
-							// Equal power panning law (+3dB boost)
-							sinCosSqrt2(&panMatrix[3], &panMatrix[0], pan * float(M_PI_2));
-						}
-						else {//if (gInfo->panLawMono == 2) {
-							// Compromise (+4.5dB boost)
-							sinCosSqrt2(&panMatrix[3], &panMatrix[0], pan * float(M_PI_2));
-							panMatrix[3] = std::sqrt( std::abs( panMatrix[3] * (pan * 2.0f) ) );
-							panMatrix[0] = std::sqrt( std::abs( panMatrix[0] * (2.0f - pan * 2.0f) ) );
-						}
-					}
-					else {// stereo
-						int stereoPanMode = (gInfo->directOutPanStereoMomentCvLinearVol.cc4[1] < 3 ? gInfo->directOutPanStereoMomentCvLinearVol.cc4[1] : panLawStereo);			
-						if (stereoPanMode == 0) {
-							// Stereo balance linear, (+0 dB), same as mono No compensation
-							panMatrix[1] = std::min(1.0f, pan * 2.0f);
-							panMatrix[0] = std::min(1.0f, 2.0f - pan * 2.0f);
-						}
-						else if (stereoPanMode == 1) {
-							// Stereo balance equal power (+3dB), same as mono Equal power
-							sinCosSqrt2(&panMatrix[1], &panMatrix[0], pan * float(M_PI_2));
-						}
-						else {
-							// True panning, equal power
-							if (pan > 0.5f) {
-								panMatrix[1] = 1.0f;
-								panMatrix[2] = 0.0f;
-								sinCos(&panMatrix[3], &panMatrix[0], (pan - 0.5f) * float(M_PI));
-							}
-							else {// must be < (not <= since = 0.5 is caught at above)
-								sinCos(&panMatrix[1], &panMatrix[2], pan * float(M_PI));
-								panMatrix[0] = 1.0f;
-								panMatrix[3] = 0.0f;
-							}
-						}
-					}
+			setSimdLane();
+		}
+	}
+	
+	
+	void setSimdLane() {
+		processEcoGainMatrix();
+		float laneVolCv = (gInfo->directOutPanStereoMomentCvLinearVol.cc4[3] != 0 ? volCv : 1.0f);
+		float group = paGroup->getValue();
+		trackSimd->setLane(trackNum, gainMatrix, laneVolCv, fadeGainScaledWithSolo, group < 0.5f ? 0.0f : (float)((int)(group - 0.5f) + 1));
+	}
+};// struct MixerTrack
+
+
+
+//*****************************************************************************
+
+
+// Structure-of-arrays post-fader stage of the tracks (pan/fader, mute-solo, VUs and adding to the mix or groups),
+//   for all tracks at once with 4 tracks in the lanes of each float_4 (tracks 1-4, 5-8, etc). The tracks do their input,
+//   insert and filter stages with processPreFilter() and processPostFilter(), and write their gainMatrix, volCv,
+//   fadeGainScaledWithSolo and group into their lane here with setLane() when eco and when they get back in use.
+// managed by Mixer
+struct MixerTrackSimd {
+	static const int N_QUAD = N_TRK / 4;
+	
+	// Constants
+	// none
+	
+	// need to save, no reset
+	// none
+	
+	// need to save, with reset
+	// none
+	
+	// no need to save, with reset
+	simd::float_4 gainMatrix[4][N_QUAD];// [L, R, RinL, LinR][track quad]
+	simd::float_4 gainMatrixSlewed[4][N_QUAD];
+	simd::float_4 volCv[N_QUAD];// 1.0f when vol CVs are not linear, since then the CV is in the gainMatrix
+	simd::float_4 muteSoloGain[N_QUAD];// fadeGainScaledWithSolo of the tracks
+	simd::float_4 muteSoloGainSlewed[N_QUAD];
+	simd::float_4 destMask[N_GRP + 1][N_QUAD];// lane masks, [0] is mix, [1..N_GRP] are groups
+	float dests[N_TRK];// 0.0f is mix, 1.0f to N_GRP are groups
+	uint32_t inUseMask;// bit t set when track t is in use (MixerTrack::oldInUse)
+	int quadUsage;// bit q set when at least one lane of quad q is in use
+	int destUsage;// bit 0 is mix, bit 1 is first group, etc.
+	VuMeterBank<N_TRK> vuBank;// VUs of the tracks
+	
+	// no need to save, no reset
+	GlobalInfo *gInfo;
+	MixerTrack *tracks;
+	float *taps;// trackTaps, see MixerTrack::taps
+	float* groupTaps;
+	
+	
+	void construct(GlobalInfo *_gInfo, MixerTrack *_tracks, float* _taps, float* _groupTaps) {
+		gInfo = _gInfo;
+		tracks = _tracks;
+		taps = _taps;
+		groupTaps = _groupTaps;
+		for (int t = 0; t < N_TRK; t++) {
+			tracks[t].trackSimd = this;
+			vuBank.setVu(t, &(tracks[t].vu));
+		}
+		vuBank.setDecimation(RefreshCounter::userInputsStepSkipMask + 1);// VUs integrated every 16 samples in any eco mode, peaks and squares accumulated in between
+	}
+	
+	
+	void reset() {
+		for (int q = 0; q < N_QUAD; q++) {
+			for (int i = 0; i < 4; i++) {
+				gainMatrix[i][q] = 0.0f;
+				gainMatrixSlewed[i][q] = 0.0f;
+			}
+			volCv[q] = 1.0f;
+			muteSoloGain[q] = 0.0f;
+			muteSoloGainSlewed[q] = 0.0f;
+			for (int d = 0; d < N_GRP + 1; d++) {
+				destMask[d][q] = 0.0f;
+			}
+		}
+		inUseMask = 0;
+		for (int t = 0; t < N_TRK; t++) {
+			dests[t] = -1.0f;// set by the first setLane()
+			if (tracks[t].oldInUse) {
+				inUseMask |= (1 << t);
+			}
+		}
+		updateUsage();
+		vuBank.reset();
+	}
+	
+	
+	void updateUsage() {
+		quadUsage = 0;
+		destUsage = 0;
+		for (int t = 0; t < N_TRK; t++) {
+			if ((inUseMask & (1 << t)) != 0) {
+				quadUsage |= (1 << (t >> 2));
+				if (dests[t] >= 0.0f) {
+					destUsage |= (1 << (int)dests[t]);
 				}
-				oldPan = pan;
 			}
-			// calc ** gainMatrix **
-			fader = std::pow(fader, GlobalConst::trkAndGrpFaderScalingExponent);// scaling
-			gainMatrix = panMatrix * fader;
 		}
-		
-		// Apply gainMatrix
-		simd::float_4 sigs(taps[N_TRK * 2 + 0], taps[N_TRK * 2 + 1], taps[N_TRK * 2 + 1], taps[N_TRK * 2 + 0]);// L, R, RinL, LinR
-		if (movemask(gainMatrix == gainMatrixSlewers.out) != 0xF) {// movemask returns 0xF when 4 floats are equal
-			gainMatrixSlewers.process(gInfo->sampleTime, gainMatrix);
+	}
+	
+	
+	void setInUse(int t, bool inUse) {// unused lanes have their gains and slewers at 0, as in MixerTrack::processUnused()
+		int q = t >> 2;
+		int lane = t & 0x3;
+		if (inUse) {
+			inUseMask |= (1 << t);
 		}
-		sigs *= gainMatrixSlewers.out;
-		taps[N_TRK * 4 + 0] = sigs[0] + sigs[2];
-		taps[N_TRK * 4 + 1] = sigs[1] + sigs[3];
-		if (gInfo->directOutPanStereoMomentCvLinearVol.cc4[3] != 0) {
-			taps[N_TRK * 4 + 0] *= volCv;
-			taps[N_TRK * 4 + 1] *= volCv;
+		else {
+			inUseMask &= ~(1 << t);
+			for (int i = 0; i < 4; i++) {
+				gainMatrix[i][q][lane] = 0.0f;
+				gainMatrixSlewed[i][q][lane] = 0.0f;
+			}
+			muteSoloGain[q][lane] = 0.0f;
+			muteSoloGainSlewed[q][lane] = 0.0f;
+			// the VUs of unused tracks are reset in MixerTrack::processUnused()
+			int quadInUse = (inUseMask >> (q << 2)) & 0xF;
+			vuBank.clearLanes(q, simd::float_4(quadInUse & 0x1, quadInUse & 0x2, quadInUse & 0x4, quadInUse & 0x8) != 0.0f);
 		}
-
-		// Calc muteSoloGainSlewed
-		if (fadeGainScaledWithSolo != muteSoloGainSlewer.out) {
-			muteSoloGainSlewer.process(gInfo->sampleTime, fadeGainScaledWithSolo);
+		updateUsage();
+	}
+	
+	
+	void clearVu(int t) {// drops what vuBank accumulated for track t, for when its VuMeterAllDual is reset
+		vuBank.clearLanes(t >> 2, simd::float_4(0.0f, 1.0f, 2.0f, 3.0f) != (float)(t & 0x3));
+	}
+	
+	
+	void setLane(int t, simd::float_4 _gainMatrix, float _volCv, float _muteSoloGain, float dest) {// only when track t is in use
+		int q = t >> 2;
+		int lane = t & 0x3;
+		for (int i = 0; i < 4; i++) {
+			gainMatrix[i][q][lane] = _gainMatrix[i];
+		}
+		volCv[q][lane] = _volCv;
+		muteSoloGain[q][lane] = _muteSoloGain;
+		if (dest != dests[t]) {
+			dests[t] = dest;
+			for (int d = 0; d < N_GRP + 1; d++) {
+				destMask[d][q] = simd::float_4::load(&dests[q << 2]) == (float)d;
+			}
+			updateUsage();
 		}
-		taps[N_TRK * 6 + 0] = taps[N_TRK * 4 + 0] * muteSoloGainSlewer.out;
-		taps[N_TRK * 6 + 1] = taps[N_TRK * 4 + 1] * muteSoloGainSlewer.out;
+	}
+	
+	
+	void process(float *mix, bool eco) {// track quads
+		simd::float_4 slewSlow = GlobalConst::antipopSlewSlow * gInfo->sampleTime;
+		simd::float_4 slewFast = GlobalConst::antipopSlewFast * gInfo->sampleTime;
+		simd::float_4 destL[N_GRP + 1];
+		simd::float_4 destR[N_GRP + 1];
+		for (int d = 0; d < N_GRP + 1; d++) {
+			destL[d] = 0.0f;
+			destR[d] = 0.0f;
+		}
+		bool cloaked = gInfo->colorAndCloak.cc4[cloakedMode] != 0;
+		bool vuOn = eco && !cloaked;
+		
+		for (int q = 0; q < N_QUAD; q++) {
+			if ((quadUsage & (1 << q)) == 0) {
+				continue;// all gains are 0 and the taps were zeroed in MixerTrack::processUnused()
+			}
+			
+			// Tap[32],[33]: pre-fader, deinterleaved such that the lanes are the tracks
+			simd::float_4 in01 = simd::float_4::load(&taps[N_TRK * 2 + (q << 3) + 0]);// L0 R0 L1 R1
+			simd::float_4 in23 = simd::float_4::load(&taps[N_TRK * 2 + (q << 3) + 4]);// L2 R2 L3 R3
+			simd::float_4 sigL = _mm_shuffle_ps(in01.v, in23.v, _MM_SHUFFLE(2, 0, 2, 0));
+			simd::float_4 sigR = _mm_shuffle_ps(in01.v, in23.v, _MM_SHUFFLE(3, 1, 3, 1));
 			
+			// Tap[64],[65]: post-fader (pan and fader)
+			for (int i = 0; i < 4; i++) {
+				gainMatrixSlewed[i][q] = simd::clamp(gainMatrix[i][q], gainMatrixSlewed[i][q] - slewSlow, gainMatrixSlewed[i][q] + slewSlow);
+			}
+			simd::float_4 postFadeL = (sigL * gainMatrixSlewed[0][q] + sigR * gainMatrixSlewed[2][q]) * volCv[q];
+			simd::float_4 postFadeR = (sigR * gainMatrixSlewed[1][q] + sigL * gainMatrixSlewed[3][q]) * volCv[q];
+			simd::float_4 out01 = _mm_unpacklo_ps(postFadeL.v, postFadeR.v);
+			simd::float_4 out23 = _mm_unpackhi_ps(postFadeL.v, postFadeR.v);
+			out01.store(&taps[N_TRK * 4 + (q << 3) + 0]);
+			out23.store(&taps[N_TRK * 4 + (q << 3) + 4]);
+			
+			// Tap[96],[97]: post-mute-solo
+			muteSoloGainSlewed[q] = simd::clamp(muteSoloGain[q], muteSoloGainSlewed[q] - slewFast, muteSoloGainSlewed[q] + slewFast);
+			simd::float_4 postSoloL = postFadeL * muteSoloGainSlewed[q];
+			simd::float_4 postSoloR = postFadeR * muteSoloGainSlewed[q];
+			out01 = _mm_unpacklo_ps(postSoloL.v, postSoloR.v);
+			out23 = _mm_unpackhi_ps(postSoloL.v, postSoloR.v);
+			out01.store(&taps[N_TRK * 6 + (q << 3) + 0]);
+			out23.store(&taps[N_TRK * 6 + (q << 3) + 4]);
 			
-		// Add to final mix or group
-		if (paGroup->getValue() < 0.5f) {
-			mix[0] += taps[N_TRK * 6 + 0];
-			mix[1] += taps[N_TRK * 6 + 1];
+			// VUs, post-fader when muted (ghost)
+			if (vuOn) {
+				simd::float_4 vuPostFader = (muteSoloGain[q] == 0.0f);
+				vuBank.accumulate(q, simd::ifelse(vuPostFader, postFadeL, postSoloL), simd::ifelse(vuPostFader, postFadeR, postSoloR));
+			}
+			
+			// Add to final mix or group
+			for (int d = 0; d < N_GRP + 1; d++) {
+				if ((destUsage & (1 << d)) != 0) {
+					destL[d] += postSoloL & destMask[d][q];
+					destR[d] += postSoloR & destMask[d][q];
+				}
+			}
 		}
-		else {
-			int groupIndex = (int)(paGroup->getValue() - 0.5f);
-			groupTaps[(groupIndex << 1) + 0] += taps[N_TRK * 6 + 0];
-			groupTaps[(groupIndex << 1) + 1] += taps[N_TRK * 6 + 1];
+		
+		// sum the lanes, L and R together: (L, R, L, R)
+		if ((destUsage & 0x1) != 0) {
+			__m128 sum = _mm_hadd_ps(destL[0].v, destR[0].v);
+			sum = _mm_hadd_ps(sum, sum);
+			mix[0] += _mm_cvtss_f32(sum);
+			mix[1] += _mm_cvtss_f32(_mm_shuffle_ps(sum, sum, 0x1));
+		}
+		for (int g = 0; g < N_GRP; g++) {
+			if ((destUsage & (2 << g)) != 0) {
+				__m128 sum = _mm_hadd_ps(destL[g + 1].v, destR[g + 1].v);
+				sum = _mm_hadd_ps(sum, sum);
+				groupTaps[(g << 1) + 0] += _mm_cvtss_f32(sum);
+				groupTaps[(g << 1) + 1] += _mm_cvtss_f32(_mm_shuffle_ps(sum, sum, 0x1));
+			}
 		}
 		
 		// VUs
-		if (gInfo->colorAndCloak.cc4[cloakedMode] != 0) {
-			vu.reset();
+		if (cloaked) {
+			for (int t = 0; t < N_TRK; t++) {
+				tracks[t].vu.reset();
+			}
+			vuBank.reset();
 		}
 		else if (eco) {
-			float sampleTimeEco = gInfo->sampleTime * (1 + (gInfo->ecoMode & 0x3));
-			vu.process(sampleTimeEco, &taps[N_TRK * (fadeGainScaledWithSolo == 0.0f ? 4 : 6) + 0]);
+			vuBank.step(gInfo->sampleTime, 1 + (gInfo->ecoMode & 0x3));
 		}
 	}
-};// struct MixerTrack
+};// struct MixerTrackSimd
+
+
+//*****************************************************************************
+// Track HPF/LPF bank, filters taps 32 and 33 of all tracks (pre-fader), two stereo tracks per float_4,
+//   or four mono tracks per float_4 when a group of four tracks has no stereo track
+
+struct MixerTrackFilterBank {
+	static const int N_QUAD = N_TRK / 2;
+	static const int N_MONO = N_TRK / 4;
+	
+	// Constants
+	// none
+	
+	// need to save, no reset
+	// none
+	
+	// need to save, with reset
+	// none
+	
+	// no need to save, with reset
+	QuattroButterworthThirdOrder hpFilter[N_QUAD];// 18dB/oct, lanes are L and R of tracks 2q and 2q+1
+	QuattroButterworthSecondOrder lpFilter[N_QUAD];// 12db/oct
+	simd::float_4 hpfOn[N_QUAD];// lane masks
+	simd::float_4 lpfOn[N_QUAD];
+	QuattroButterworthThirdOrder monoHpFilter[N_MONO];// lanes are L of tracks 4m to 4m+3
+	QuattroButterworthSecondOrder monoLpFilter[N_MONO];
+	simd::float_4 monoHpfOn[N_MONO];// lane masks
+	simd::float_4 monoLpfOn[N_MONO];
+	int monoGroups;// bit m set when the tracks 4m to 4m+3 were filtered with the mono filters
+	float lastHpfCutoff[N_TRK];
+	float lastLpfCutoff[N_TRK];
+	int hpfUsage;// bit q set when at least one lane of quad q has its HPF on
+	int lpfUsage;
+	
+	// no need to save, no reset
+	GlobalInfo *gInfo;
+	MixerTrack *tracks;
+	float *taps;// trackTaps, see MixerTrack::taps
+	
+	
+	void construct(GlobalInfo *_gInfo, MixerTrack *_tracks, float* _taps) {
+		gInfo = _gInfo;
+		tracks = _tracks;
+		taps = _taps;
+		for (int t = 0; t < N_TRK; t++) {
+			lastHpfCutoff[t] = -1.0f;
+			lastLpfCutoff[t] = -1.0f;
+		}
+		hpfUsage = 0;
+		lpfUsage = 0;
+		monoGroups = 0;
+	}
+	
+	
+	void reset() {
+		for (int q = 0; q < N_QUAD; q++) {
+			hpFilter[q].reset();
+			lpFilter[q].reset();
+		}
+		for (int m = 0; m < N_MONO; m++) {
+			monoHpFilter[m].reset();
+			monoLpFilter[m].reset();
+		}
+		onSampleRateChange();
+	}
+	
+	
+	void onSampleRateChange() {
+		for (int t = 0; t < N_TRK; t++) {
+			setHPFCutoffFreq(t, tracks[t].getHPFCutoffFreq());
+			setLPFCutoffFreq(t, tracks[t].getLPFCutoffFreq());
+		}
+	}
+	
+	
+	void setHPFCutoffFreq(int t, float fc) {
+		lastHpfCutoff[t] = fc;
+		int q = t >> 1;
+		int lane = (t & 0x1) << 1;
+		fc *= gInfo->sampleTime;// fc is in normalized freq for rest of method
+		for (int c = 0; c < 2; c++) {
+			hpFilter[q].setParameters(lane + c, true, fc);
+		}
+		int m = t >> 2;
+		monoHpFilter[m].setParameters(t & 0x3, true, fc);
+		float on0 = lastHpfCutoff[q << 1] >= GlobalConst::minHPFCutoffFreq ? 1.0f : 0.0f;
+		float on1 = lastHpfCutoff[(q << 1) + 1] >= GlobalConst::minHPFCutoffFreq ? 1.0f : 0.0f;
+		hpfOn[q] = simd::float_4(on0, on0, on1, on1) != 0.0f;
+		monoHpfOn[m] = simd::float_4(lastHpfCutoff[m << 2], lastHpfCutoff[(m << 2) + 1], lastHpfCutoff[(m << 2) + 2], lastHpfCutoff[(m << 2) + 3]) >= GlobalConst::minHPFCutoffFreq;
+		if (simd::movemask(hpfOn[q]) != 0) {
+			hpfUsage |= (1 << q);
+		}
+		else {
+			hpfUsage &= ~(1 << q);
+		}
+	}
+	
+	
+	void setLPFCutoffFreq(int t, float fc) {
+		lastLpfCutoff[t] = fc;
+		int q = t >> 1;
+		int lane = (t & 0x1) << 1;
+		fc *= gInfo->sampleTime;// fc is in normalized freq for rest of method
+		for (int c = 0; c < 2; c++) {
+			lpFilter[q].setParameters(lane + c, false, fc);
+		}
+		int m = t >> 2;
+		monoLpFilter[m].setParameters(t & 0x3, false, fc);
+		float on0 = lastLpfCutoff[q << 1] <= GlobalConst::maxLPFCutoffFreq ? 1.0f : 0.0f;
+		float on1 = lastLpfCutoff[(q << 1) + 1] <= GlobalConst::maxLPFCutoffFreq ? 1.0f : 0.0f;
+		lpfOn[q] = simd::float_4(on0, on0, on1, on1) != 0.0f;
+		monoLpfOn[m] = simd::float_4(lastLpfCutoff[m << 2], lastLpfCutoff[(m << 2) + 1], lastLpfCutoff[(m << 2) + 2], lastLpfCutoff[(m << 2) + 3]) <= GlobalConst::maxLPFCutoffFreq;
+		if (simd::movemask(lpfOn[q]) != 0) {
+			lpfUsage |= (1 << q);
+		}
+		else {
+			lpfUsage &= ~(1 << q);
+		}
+	}
+	
+	
+	void updateSlowValues(int t) {// call after tracks[t].updateSlowValues()
+		if (tracks[t].getHPFCutoffFreq() != lastHpfCutoff[t]) {
+			setHPFCutoffFreq(t, tracks[t].getHPFCutoffFreq());
+		}
+		if (tracks[t].getLPFCutoffFreq() != lastLpfCutoff[t]) {
+			setLPFCutoffFreq(t, tracks[t].getLPFCutoffFreq());
+		}
+	}
+	
+	
+	// call after MixerTrack::processPreFilter() of all tracks and before their MixerTrack::processPostFilter()
+	void process() {
+		int usage = hpfUsage | lpfUsage;
+		if (usage == 0) {
+			return;
+		}
+		for (int m = 0; m < N_MONO; m++) {
+			if ((usage & (0x3 << (m << 1))) == 0) {
+				continue;
+			}
+			MixerTrack *quadTracks = &tracks[m << 2];
+			bool mono = !(quadTracks[0].stereo || quadTracks[1].stereo || quadTracks[2].stereo || quadTracks[3].stereo);
+			if (mono != ((monoGroups & (1 << m)) != 0)) {// the other filters have stale state
+				monoGroups ^= (1 << m);
+				if (mono) {
+					monoHpFilter[m].reset();
+					monoLpFilter[m].reset();
+				}
+				else {
+					for (int q = (m << 1); q < (m << 1) + 2; q++) {
+						hpFilter[q].reset();
+						lpFilter[q].reset();
+					}
+				}
+			}
+			if (mono) {
+				processMono(m);
+			}
+			else {
+				processStereo(m << 1);
+				processStereo((m << 1) + 1);
+			}
+		}
+	}
+	
+	
+	void processStereo(int q) {
+		// lanes of unused tracks are masked so that their taps stay at zero
+		simd::float_4 inUse = simd::float_4(tracks[2 * q].oldInUse, tracks[2 * q].oldInUse, tracks[2 * q + 1].oldInUse, tracks[2 * q + 1].oldInUse) != 0.0f;
+		simd::float_4 hpMask = hpfOn[q] & inUse;
+		simd::float_4 lpMask = lpfOn[q] & inUse;
+		if (simd::movemask(hpMask | lpMask) == 0) {
+			return;
+		}
+		float *quadTaps = &taps[N_TRK * 2 + (q << 2)];
+		simd::float_4 sig = simd::float_4::load(quadTaps);
+		if (simd::movemask(hpMask) != 0) {
+			sig = simd::ifelse(hpMask, hpFilter[q].process(sig), sig);
+		}
+		if (simd::movemask(lpMask) != 0) {
+			sig = simd::ifelse(lpMask, lpFilter[q].process(sig), sig);
+		}
+		sig.store(quadTaps);
+	}
+	
+	
+	void processMono(int m) {// only the L taps, MixerTrack::processPostFilter() copies them to R for mono tracks
+		MixerTrack *quadTracks = &tracks[m << 2];
+		simd::float_4 inUse = simd::float_4(quadTracks[0].oldInUse, quadTracks[1].oldInUse, quadTracks[2].oldInUse, quadTracks[3].oldInUse) != 0.0f;
+		simd::float_4 hpMask = monoHpfOn[m] & inUse;
+		simd::float_4 lpMask = monoLpfOn[m] & inUse;
+		if (simd::movemask(hpMask | lpMask) == 0) {
+			return;
+		}
+		float *monoTaps = &taps[N_TRK * 2 + (m << 3)];// L0 R0 L1 R1 L2 R2 L3 R3
+		simd::float_4 sig = simd::float_4(monoTaps[0], monoTaps[2], monoTaps[4], monoTaps[6]);
+		if (simd::movemask(hpMask) != 0) {
+			sig = simd::ifelse(hpMask, monoHpFilter[m].process(sig), sig);
+		}
+		if (simd::movemask(lpMask) != 0) {
+			sig = simd::ifelse(lpMask, monoLpFilter[m].process(sig), sig);
+		}
+		for (int i = 0; i < 4; i++) {
+			monoTaps[i << 1] = sig[i];
+		}
+	}
+};// struct MixerTrackFilterBank
 
 
 
@@ -2131,7 +2529,7 @@ struct MixerAux {
 				if (isFadeMode()) {
 					float deltaX = (gInfo->sampleTime / *fadeRate) * (1 + (gInfo->ecoMode & 0x3));// last value is sub refresh
 					fadeGain = updateFadeGain(fadeGain, target, &fadeGainX, &fadeGainXr, deltaX, *fadeProfile, gInfo->symmetricalFade);
-					fadeGainScaled = std::pow(fadeGain, GlobalConst::globalAuxReturnScalingExponent);
+					fadeGainScaled = powInt(fadeGain, GlobalConst::globalAuxReturnScalingExponent);
 				}
 				else {// we are in mute mode
 					fadeGain = target;
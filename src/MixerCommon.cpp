@@ -19,13 +19,37 @@
 
 // Utility
 
+// exp and log fade curves of updateFadeGain(), tabulated over the fade position since they are evaluated per sample
+//   while fading, in every track, group, aux return and master
+struct FadeCurves {
+	static const int SIZE = 1024;// segments, the log curve is steepest at 0 where its error is below 1e-4
+	float expCurve[SIZE + 1];// (e^(A*x) - 1) / (e^A - 1)
+	float logCurve[SIZE + 1];// log(x * (e^A - 1) + 1) / A, inverse of the above
+	
+	FadeCurves(float A) {
+		double e_a_m1 = std::exp((double)A) - 1.0;
+		for (int i = 0; i <= SIZE; i++) {
+			double x = (double)i / SIZE;
+			expCurve[i] = (float)((std::exp(A * x) - 1.0) / e_a_m1);
+			logCurve[i] = (float)(std::log(x * e_a_m1 + 1.0) / A);
+		}
+	}
+	
+	static float lookup(const float* curve, float x) {// linear interpolation, extrapolated past 0 and 1
+		float pos = x * SIZE;
+		int i = clamp((int)pos, 0, SIZE - 1);
+		return curve[i] + (curve[i + 1] - curve[i]) * (pos - (float)i);
+	}
+};
+
+
 float updateFadeGain(float fadeGain, float target, float *fadeGainX, float *fadeGainXr, float timeStepX, float shape, bool symmetricalFade) {
 	// shape is 1.0f when exp, 0.0f when lin, -1.0f when log
 	// target is 0.0f or 1.0f
 	// fadeGainX moves from 0.0f to 1.0f gradually and linearly
 	// fadeGainXr is a resettable and relative gainX, which is used for non-symmetrical fades (to remember position when change direction while fade is happening
 	static const float A = 4.0f;
-	static const float E_A_M1 = (std::exp(A) - 1.0f);// e^A - 1
+	static const FadeCurves curves(A);
 	
 	float newFadeGain;
 
@@ -47,11 +71,11 @@ float updateFadeGain(float fadeGain, float target, float *fadeGainX, float *fade
 		newFadeGain = *fadeGainX;// linear
 		if (*fadeGainX != target) {
 			if (shape > 0.0f) {	
-				float expY = (std::exp(A * *fadeGainX) - 1.0f)/E_A_M1;
+				float expY = FadeCurves::lookup(curves.expCurve, *fadeGainX);
 				newFadeGain = crossfade(newFadeGain, expY, shape);
 			}
 			else if (shape < 0.0f) {
-				float logY = std::log(*fadeGainX * E_A_M1 + 1.0f) / A;
+				float logY = FadeCurves::lookup(curves.logCurve, *fadeGainX);
 				newFadeGain = crossfade(newFadeGain, logY, -1.0f * shape);		
 			}
 		}
@@ -60,11 +84,11 @@ float updateFadeGain(float fadeGain, float target, float *fadeGainX, float *fade
 		float fadeGainDelta = timeStepX;// linear
 		
 		if (shape > 0.0f) {	
-			float fadeGainDeltaExp = (std::exp(A * (*fadeGainXr)) - std::exp(A * (*fadeGainXr - timeStepX))) / E_A_M1;
+			float fadeGainDeltaExp = FadeCurves::lookup(curves.expCurve, *fadeGainXr) - FadeCurves::lookup(curves.expCurve, *fadeGainXr - timeStepX);
 			fadeGainDelta = crossfade(fadeGainDelta, fadeGainDeltaExp, shape);
 		}
 		else if (shape < 0.0f) {
-			float fadeGainDeltaLog = (std::log((*fadeGainXr) * E_A_M1 + 1.0f) - std::log((*fadeGainXr - timeStepX) * E_A_M1 + 1.0f)) / A;
+			float fadeGainDeltaLog = FadeCurves::lookup(curves.logCurve, *fadeGainXr) - FadeCurves::lookup(curves.logCurve, *fadeGainXr - timeStepX);
 			fadeGainDelta = crossfade(fadeGainDelta, fadeGainDeltaLog, -1.0f * shape);		
 		}
 		
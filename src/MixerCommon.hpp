@@ -10,6 +10,7 @@
 #include "MindMeldModular.hpp"
 #include "dsp/FirstOrderFilter.hpp"
 #include "dsp/ButterworthFilters.hpp"
+#include "dsp/LoudnessMeter.hpp"
 
 
 
@@ -104,6 +105,15 @@ static inline float calcDimGainIntegerDB(float dimGain) {
 	return std::pow(10.0f, integerDB / 20.0f);
 }
 
+// x^exponent with multiplications only, for the fader scaling exponents above (exponent >= 1)
+static inline float powInt(float x, int exponent) {
+	float y = x;
+	for (int i = 1; i < exponent; i++) {
+		y *= x;
+	}
+	return y;
+}
+
 
 
 //*****************************************************************************
@@ -1064,6 +1064,56 @@ struct ClippingItem : MenuItem {
 };
 
 
+// loudness
+struct LoudnessItem : MenuItem {
+	LoudnessMeter *loudnessSrc;
+
+	struct LoudnessLabel : MenuLabel {// live value, refreshed in step()
+		LoudnessMeter *loudnessSrc;
+		std::string name;
+		std::string unit;
+		float LoudnessValues::*value;
+		
+		void step() override {
+			LoudnessValues values;
+			if (loudnessSrc->read(&values)) {
+				float v = values.*value;
+				text = name + (v <= -70.0f ? std::string("-inf ") : string::f("%.1f ", v)) + unit;
+			}
+			MenuLabel::step();
+		}
+	};
+
+	struct ResetIntegratedItem : MenuItem {
+		LoudnessMeter *loudnessSrc;
+		void onAction(const event::Action &e) override {
+			loudnessSrc->resetIntegratedRequest.store(true);
+		}
+	};
+
+	Menu *createChildMenu() override {
+		Menu *menu = new Menu;
+
+		const char* names[4] = {"Momentary: ", "Short-term: ", "Integrated: ", "True-peak max: "};
+		float LoudnessValues::*values[4] = {&LoudnessValues::momentary, &LoudnessValues::shortTerm, &LoudnessValues::integrated, &LoudnessValues::truePeak};
+		for (int i = 0; i < 4; i++) {
+			LoudnessLabel *valueLabel = new LoudnessLabel();
+			valueLabel->loudnessSrc = loudnessSrc;
+			valueLabel->name = names[i];
+			valueLabel->unit = i < 3 ? "LUFS" : "dBTP";
+			valueLabel->value = values[i];
+			menu->addChild(valueLabel);
+		}
+
+		ResetIntegratedItem *resetItem = createMenuItem<ResetIntegratedItem>("Reset integrated and true-peak", "");
+		resetItem->loudnessSrc = loudnessSrc;
+		menu->addChild(resetItem);
+
+		return menu;
+	}
+};
+
+
 // masterFaderScalesSends
 struct MasterFaderScalesSendsItem : MenuItem {
 	int8_t *masterFaderScalesSendsSrc;
@@ -10,10 +10,8 @@
 
 #pragma once
 
-#include <string>
-#include <vector>
-#include <mutex>
-#include <unordered_map>
+#include <atomic>
+#include <cstring>
 #include <cstdint>
 
 
@@ -23,6 +21,7 @@ struct MessageBase {
 };
 
 struct MixerMessage : MessageBase {
+	uint32_t generation;// changes each time the sender publishes different content, 0 when blank
 	bool isJr;
 	char trkGrpAuxLabels[(16 + 4 + 4) * 4];
 	int8_t vuColors[1 + 16 + 4 + 4];// room for global, tracks, groups, aux
@@ -30,75 +29,200 @@ struct MixerMessage : MessageBase {
 };
 
 
+// Each mixer publishes into its own slot, which only it writes; readers copy a slot without blocking and retry when 
+//   the copy overlapped a write (sequence counter is odd during a write, and changes with each write).
+// A slot is only written when its content changes, and then gets a new generation (unique in the bus), so that 
+//   subscribers can poll getGeneration() and only receive() when it differs from the generation they last received.
 struct MixerMessageBus {
-	std::mutex memberMutex;
-	std::unordered_map<int, MixerMessage> memberData;// first value is a "Module::id + 1" (so that 0 = deregistered, instead of -1)
+	static const int MAX_MEMBERS = 128;// mixers registered at once, sends from more mixers are ignored
+	
+	struct Slot {
+		std::atomic<int> id;// "Module::id + 1" of the owner (so that 0 = free, instead of -1)
+		std::atomic<uint32_t> seq;
+		std::atomic<uint32_t> generation;// same as data.generation
+		MixerMessage data;// blank when free
+	};
+	Slot slots[MAX_MEMBERS];
+	std::atomic<uint32_t> lastGeneration;
+	
+	
+	MixerMessageBus() {
+		for (int i = 0; i < MAX_MEMBERS; i++) {
+			slots[i].id.store(0);
+			slots[i].seq.store(0);
+			slots[i].generation.store(0);
+			slots[i].data = MixerMessage();
+		}
+		lastGeneration.store(0);
+	}
 
 
 	void send(int id, char* masterLabel, char* trackLabels, char* auxLabels, int8_t *_vuColors, int8_t *_dispColors) {
-		std::lock_guard<std::mutex> lock(memberMutex);
-		memberData[id].id = id;
-		memcpy(memberData[id].name, masterLabel, 6);
-		memberData[id].isJr = false;
-		memcpy(memberData[id].trkGrpAuxLabels, trackLabels, (16 + 4) * 4);// grabs groups also since contiguous
-		memcpy(&memberData[id].trkGrpAuxLabels[(16 + 4) * 4], auxLabels, 4 * 4);
-		memberData[id].vuColors[0] = _vuColors[0];
+		Slot* slot = claimSlot(id);
+		if (slot == NULL) {
+			return;
+		}
+		MixerMessage newMessage;
+		memcpy(&newMessage, &slot->data, sizeof(MixerMessage));// the owner can read its own slot directly
+		MixerMessage* message = &newMessage;
+		message->id = id;
+		memcpy(message->name, masterLabel, 6);
+		message->isJr = false;
+		memcpy(message->trkGrpAuxLabels, trackLabels, (16 + 4) * 4);// grabs groups also since contiguous
+		memcpy(&message->trkGrpAuxLabels[(16 + 4) * 4], auxLabels, 4 * 4);
+		message->vuColors[0] = _vuColors[0];
 		if (_vuColors[0] >= 5) {
-			memcpy(&memberData[id].vuColors[1], &_vuColors[1], 16 + 4 + 4);
+			memcpy(&message->vuColors[1], &_vuColors[1], 16 + 4 + 4);
 		}
-		memberData[id].dispColors[0] = _dispColors[0];
+		message->dispColors[0] = _dispColors[0];
 		if (_dispColors[0] >= 7) {
-			memcpy(&memberData[id].dispColors[1], &_dispColors[1], 16 + 4 + 4);
+			memcpy(&message->dispColors[1], &_dispColors[1], 16 + 4 + 4);
 		}
+		publish(slot, message);
 	}
 	void sendJr(int id, char* masterLabel, char* trackLabels, char* groupLabels, char* auxLabels, int8_t *_vuColors, int8_t *_dispColors) {// does not write to tracks 9-16 and groups 3-4 when jr.
-		std::lock_guard<std::mutex> lock(memberMutex);
-		memberData[id].id = id;
-		memcpy(memberData[id].name, masterLabel, 6);
-		memberData[id].isJr = true;
-		memcpy(memberData[id].trkGrpAuxLabels, trackLabels, 8 * 4);
-		memcpy(&memberData[id].trkGrpAuxLabels[16 * 4], groupLabels, 2 * 4);
-		memcpy(&memberData[id].trkGrpAuxLabels[(16 + 4) * 4], auxLabels, 4 * 4);
-		memberData[id].vuColors[0] = _vuColors[0];
+		Slot* slot = claimSlot(id);
+		if (slot == NULL) {
+			return;
+		}
+		MixerMessage newMessage;
+		memcpy(&newMessage, &slot->data, sizeof(MixerMessage));// the owner can read its own slot directly
+		MixerMessage* message = &newMessage;
+		message->id = id;
+		memcpy(message->name, masterLabel, 6);
+		message->isJr = true;
+		memcpy(message->trkGrpAuxLabels, trackLabels, 8 * 4);
+		memcpy(&message->trkGrpAuxLabels[16 * 4], groupLabels, 2 * 4);
+		memcpy(&message->trkGrpAuxLabels[(16 + 4) * 4], auxLabels, 4 * 4);
+		message->vuColors[0] = _vuColors[0];
 		if (_vuColors[0] >= 5) {
-			memcpy(&memberData[id].vuColors[1], &_vuColors[1], 8);
-			memcpy(&memberData[id].vuColors[1 + 16], &_vuColors[1 + 16], 2);
-			memcpy(&memberData[id].vuColors[1 + 16 + 4], &_vuColors[1 + 16 + 4], 4);
+			memcpy(&message->vuColors[1], &_vuColors[1], 8);
+			memcpy(&message->vuColors[1 + 16], &_vuColors[1 + 16], 2);
+			memcpy(&message->vuColors[1 + 16 + 4], &_vuColors[1 + 16 + 4], 4);
 		}
-		memberData[id].dispColors[0] = _dispColors[0];
+		message->dispColors[0] = _dispColors[0];
 		if (_dispColors[0] >= 7) {
-			memcpy(&memberData[id].dispColors[1], &_dispColors[1], 8);
-			memcpy(&memberData[id].dispColors[1 + 16], &_dispColors[1 + 16], 2);
-			memcpy(&memberData[id].dispColors[1 + 16 + 4], &_dispColors[1 + 16 + 4], 4);
+			memcpy(&message->dispColors[1], &_dispColors[1], 8);
+			memcpy(&message->dispColors[1 + 16], &_dispColors[1 + 16], 2);
+			memcpy(&message->dispColors[1 + 16 + 4], &_dispColors[1 + 16 + 4], 4);
 		}
+		publish(slot, message);
 	}
 
 
-	void receive(MixerMessage* message) {// id of sender we want to receive from must be in message->id, other fields will be filled by this method as the receive mechanism. If non-existing sender is requested, a blank message with an id of 0 will be returned
-		std::lock_guard<std::mutex> lock(memberMutex);
+	bool receive(MixerMessage* message) {// id of sender we want to receive from must be in message->id, other fields will be filled by this method as the receive mechanism. If non-existing sender is requested, a blank message with an id of 0 will be returned
+		// returns false and leaves message untouched when the sender was writing during every try, receive again later
 		int id = message->id;
-		*message = memberData[id];
+		Slot* slot = findSlot(id);
+		if (slot != NULL) {
+			MixerMessage copy;
+			if (!readSlot(slot, &copy, sizeof(MixerMessage))) {
+				return false;
+			}
+			if (copy.id == id) {
+				*message = copy;
+				return true;
+			}
+		}
+		*message = MixerMessage();
+		return true;
 	}
 
 
-	std::vector<MessageBase>* surveyValues() {// caller must delete returned value when non null. Does not use MixerMessage type since don't want all the data, just the header info (id and name)
-		std::lock_guard<std::mutex> lock(memberMutex);
+	uint32_t getGeneration(int id) {// generation of the last content published by this sender, 0 if not registered
+		Slot* slot = findSlot(id);
+		return slot != NULL ? slot->generation.load(std::memory_order_acquire) : 0;
+	}
+
 
-		std::vector<MessageBase> *data = new std::vector<MessageBase>();
-		for (const auto &e : memberData) {
-			if (e.second.id != 0) {
-				MessageBase newMessage;
-				newMessage.id = e.second.id;
-				memcpy(newMessage.name, e.second.name, 6);
-				data->push_back(newMessage);
+	int surveyValues(MessageBase* dest, int maxNum) {// fills dest with the header info (id and name) of up to maxNum registered mixers, returns how many
+		int num = 0;
+		for (int i = 0; i < MAX_MEMBERS && num < maxNum; i++) {
+			if (slots[i].id.load(std::memory_order_acquire) != 0) {
+				if (readSlot(&slots[i], &dest[num], sizeof(MessageBase)) && dest[num].id != 0) {
+					num++;
+				}
 			}
 		}
-
-		return data;
+		return num;
 	}
 
 	void deregisterMember(int id) {
-		std::lock_guard<std::mutex> lock(memberMutex);
-		memberData.erase(id);
+		Slot* slot = findSlot(id);
+		if (slot != NULL) {
+			beginWrite(slot);
+			slot->data = MixerMessage();
+			endWrite(slot);
+			slot->generation.store(0, std::memory_order_release);
+			slot->id.store(0, std::memory_order_release);
+		}
+	}
+	
+	
+	private:
+	
+	Slot* findSlot(int id) {// id must be > 0, since 0 is the id of the free slots
+		if (id <= 0) {
+			return NULL;
+		}
+		for (int i = 0; i < MAX_MEMBERS; i++) {
+			if (slots[i].id.load(std::memory_order_acquire) == id) {
+				return &slots[i];
+			}
+		}
+		return NULL;
+	}
+	
+	Slot* claimSlot(int id) {// only the owner writes to its slot, so a slot found for this id stays its own
+		if (id <= 0) {// Module::id is -1 until the module is added to the engine, so "id + 1" can be 0
+			return NULL;
+		}
+		Slot* slot = findSlot(id);
+		if (slot != NULL) {
+			return slot;
+		}
+		for (int i = 0; i < MAX_MEMBERS; i++) {
+			int expected = 0;
+			if (slots[i].id.compare_exchange_strong(expected, id, std::memory_order_acq_rel)) {
+				return &slots[i];
+			}
+		}
+		return NULL;
+	}
+	
+	void publish(Slot* slot, MixerMessage* message) {// writes the slot only when the content changed
+		message->generation = slot->data.generation;
+		if (memcmp(message, &slot->data, sizeof(MixerMessage)) == 0) {
+			return;
+		}
+		message->generation = lastGeneration.fetch_add(1, std::memory_order_relaxed) + 1;
+		beginWrite(slot);
+		memcpy(&slot->data, message, sizeof(MixerMessage));
+		endWrite(slot);
+		slot->generation.store(message->generation, std::memory_order_release);
+	}
+	
+	void beginWrite(Slot* slot) {
+		slot->seq.store(slot->seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+	
+	void endWrite(Slot* slot) {
+		slot->seq.store(slot->seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+	
+	bool readSlot(Slot* slot, void* dest, size_t size) {// copies the first size bytes of the slot's message, returns false when no consistent copy could be made
+		for (int tries = 0; tries < 8; tries++) {
+			uint32_t s0 = slot->seq.load(std::memory_order_acquire);
+			if ((s0 & 0x1) != 0) {
+				continue;
+			}
+			memcpy(dest, &slot->data, size);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot->seq.load(std::memory_order_relaxed) == s0) {
+				return true;
+			}
+		}
+		return false;
 	}
 };
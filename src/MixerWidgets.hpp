@@ -501,6 +501,7 @@ struct MasterDisplay : EditableDisplayBase {
 	float* dimGainIntegerDB;
 	int* idSrc;
 	int8_t* masterFaderScalesSendsSrc;
+	LoudnessMeter* loudness;
 	
 	MasterDisplay() {
 		numChars = 6;
@@ -538,6 +539,10 @@ struct MasterDisplay : EditableDisplayBase {
 			clipItem->clippingSrc = clipping;
 			menu->addChild(clipItem);
 
+			LoudnessItem *loudItem = createMenuItem<LoudnessItem>("Loudness", RIGHT_ARROW);
+			loudItem->loudnessSrc = loudness;
+			menu->addChild(loudItem);
+
 			MasterFaderScalesSendsItem *mastScaleSendItem = createMenuItem<MasterFaderScalesSendsItem>("Apply master fader to aux sends", CHECKMARK(*masterFaderScalesSendsSrc != 0));
 			mastScaleSendItem->masterFaderScalesSendsSrc = masterFaderScalesSendsSrc;
 			menu->addChild(mastScaleSendItem);
@@ -46,6 +46,10 @@ void VuMeterBase::processPeakHold() {// use APP->window->getLastFrameRate()
 
 
 void VuMeterBase::draw(const DrawArgs &args) {
+	if (drawnByBridge) {
+		return;
+	}
+	
 	processPeakHold();
 	
 	setColor();
@@ -256,3 +260,100 @@ void VuMeterBase::drawPeakHoldMaster(const DrawArgs &args, float holdValue, floa
 		}
 	}
 }
+
+
+
+// VuMeterBridge
+
+void VuMeterBridge::addVuRects(int pass, int color, VuMeterBase* meter, float vuValue, float posX) {
+	// same geometry as VuMeterBase::drawVu() and VuMeterBase::drawPeakHold(), pass 2 is the peak hold
+	if (vuValue >= VuMeterBase::epsilon) {
+		float barX = meter->barX;
+		float barY = meter->barY;
+		float redThreshold = meter->redThreshold;
+		float posY = meter->box.pos.y;
+		
+		float vuHeight = vuValue / (VuMeterBase::faderMaxLinearGain * VuMeterBase::zeroDbVoltage);
+		vuHeight = std::pow(vuHeight, 1.0f / VuMeterBase::faderScalingExponent);
+		vuHeight = std::min(vuHeight, 1.0f);// normalized is now clamped
+		vuHeight *= barY;
+		
+		std::vector<Rect>* greenRects = &batchRects[(pass * 2 + 0) * numBatchColors + color];
+		std::vector<Rect>* topRects = &batchRects[(pass * 2 + 1) * numBatchColors + (color == numVuThemes ? numVuThemes : 0)];// yellow-red does not depend on the theme
+		if (pass == 2) {
+			if (vuHeight >= redThreshold) {
+				topRects->push_back(Rect(Vec(posX, posY + barY - vuHeight - sepYtrack - VuMeterBase::peakHoldThick), Vec(barX, VuMeterBase::peakHoldThick)));
+			}
+			else {
+				greenRects->push_back(Rect(Vec(posX, posY + barY - vuHeight), Vec(barX, VuMeterBase::peakHoldThick)));
+			}
+		}
+		else {
+			if (vuHeight >= redThreshold) {
+				topRects->push_back(Rect(Vec(posX, posY + barY - vuHeight - sepYtrack), Vec(barX, vuHeight - redThreshold)));
+				greenRects->push_back(Rect(Vec(posX, posY + barY - redThreshold), Vec(barX, redThreshold)));
+			}
+			else {
+				greenRects->push_back(Rect(Vec(posX, posY + barY - vuHeight), Vec(barX, vuHeight)));
+			}
+		}
+	}
+}
+
+
+void VuMeterBridge::draw(const DrawArgs &args) {
+	if (meters.empty()) {
+		return;
+	}
+	
+	// collect
+	for (int i = 0; i < numBatches; i++) {
+		batchRects[i].clear();
+	}
+	for (VuMeterBase* meter : meters) {
+		meter->processPeakHold();
+		meter->setColor();
+		bool ghostMuteOn = (meter->srcMuteGhost != NULL && *meter->srcMuteGhost == 0.0f);
+		int color = ghostMuteOn ? numVuThemes : meter->colorTheme;
+		for (int i = 0; i < 2; i++) {
+			float posX = meter->box.pos.x + (i == 0 ? 0.0f : meter->barX + meter->gapX);
+			addVuRects(0, color, meter, VuMeterAllDual::getPeak(meter->srcLevels, i), posX);
+			addVuRects(1, color, meter, VuMeterAllDual::getRms(meter->srcLevels, i), posX);
+			addVuRects(2, color, meter, meter->peakHold[i], posX);
+		}
+	}
+	
+	// draw, in pass order so that the rms is over the peak and the peak hold is over both
+	float barY = meters[0]->barY;
+	float redThreshold = meters[0]->redThreshold;
+	float posY = meters[0]->box.pos.y;
+	for (int pass = 0; pass < 3; pass++) {
+		int colorIndex = (pass == 0 ? 0 : 1);// peak (darker), rms and peak hold (lighter)
+		for (int part = 0; part < 2; part++) {
+			for (int color = 0; color < numBatchColors; color++) {
+				std::vector<Rect>* rects = &batchRects[(pass * 2 + part) * numBatchColors + color];
+				if (rects->empty()) {
+					continue;
+				}
+				bool gray = (color == numVuThemes);
+				NVGpaint paint;
+				if (part == 0) {
+					NVGcolor colTop = gray ? VU_GRAY_TOP[colorIndex] : VU_THEMES_TOP[color][colorIndex];
+					NVGcolor colBot = gray ? VU_GRAY_BOT[colorIndex] : VU_THEMES_BOT[color][colorIndex];
+					paint = nvgLinearGradient(args.vg, 0, posY + barY - redThreshold, 0, posY + barY, colTop, colBot);
+				}
+				else {
+					NVGcolor colTopRed = gray ? VU_GRAY_TOP[colorIndex] : VU_RED[colorIndex];
+					NVGcolor colTopYel = gray ? VU_GRAY_TOP[colorIndex] : VU_YELLOW[colorIndex];
+					paint = nvgLinearGradient(args.vg, 0, posY, 0, posY + barY - redThreshold - sepYtrack, colTopRed, colTopYel);
+				}
+				nvgBeginPath(args.vg);
+				for (const Rect& r : *rects) {
+					nvgRect(args.vg, r.pos.x, r.pos.y, r.size.x, r.size.y);
+				}
+				nvgFillPaint(args.vg, paint);
+				nvgFill(args.vg);
+			}
+		}
+	}
+}
@@ -61,6 +61,118 @@ struct VuMeterAllDual {
 };
 
 
+// Bank of N stereo VUs processed four at a time, where the lanes of a float_4 are four VUs; for owners that already have 
+//   the signals of four tracks in the lanes of a float_4. The state stays in each VU's VuMeterAllDual, so that the displays 
+//   and VuMeterAllDual::reset() are unchanged.
+// decimation: in samples, the peaks and squares accumulated over at least that many samples are integrated at once,
+//   1 is the same as VuMeterAllDual::process()
+template <int N>
+struct VuMeterBank {
+	static const int N_QUAD = (N + 3) / 4;
+	
+	float *vuValues[N_QUAD * 4];// vuValues of each VuMeterAllDual, lanes past N point to dummyValues
+	float dummyValues[4];
+	simd::float_4 peakAcc[2][N_QUAD];// [L, R][quad]
+	simd::float_4 squareAcc[2][N_QUAD];
+	int decimation;
+	int count;// accumulate() steps since the last integration
+	int countSamples;// samples covered by those steps
+	
+	
+	VuMeterBank() {
+		for (int i = 0; i < 4; i++) {
+			dummyValues[i] = 0.0f;
+		}
+		for (int i = 0; i < N_QUAD * 4; i++) {
+			vuValues[i] = dummyValues;
+		}
+		decimation = 1;
+		reset();
+	}
+	
+	void setVu(int i, VuMeterAllDual *vu) {
+		vuValues[i] = vu->vuValues;
+	}
+	
+	void setDecimation(int _decimation) {
+		decimation = std::max(_decimation, 1);
+		reset();
+	}
+	
+	void reset() {
+		for (int q = 0; q < N_QUAD; q++) {
+			for (int i = 0; i < 2; i++) {
+				peakAcc[i][q] = 0.0f;
+				squareAcc[i][q] = 0.0f;
+			}
+		}
+		count = 0;
+		countSamples = 0;
+	}
+	
+	void clearLanes(int q, simd::float_4 keepMask) {// drop what was accumulated for the VUs not in keepMask, for when their VuMeterAllDual was reset
+		for (int i = 0; i < 2; i++) {
+			peakAcc[i][q] &= keepMask;
+			squareAcc[i][q] &= keepMask;
+		}
+	}
+	
+	void accumulate(int q, simd::float_4 sigL, simd::float_4 sigR) {// call for each quad, then step()
+		peakAcc[0][q] = simd::fmax(peakAcc[0][q], simd::abs(sigL));
+		peakAcc[1][q] = simd::fmax(peakAcc[1][q], simd::abs(sigR));
+		squareAcc[0][q] += sigL * sigL;
+		squareAcc[1][q] += sigR * sigR;
+	}
+	
+	void step(float sampleTime, int stepSamples) {// stepSamples: samples since the previous step() (more than 1 when the owner skips samples)
+		count++;
+		countSamples += stepSamples;
+		if (countSamples < decimation) {
+			return;
+		}
+		float deltaTimeAcc = sampleTime * (float)countSamples;
+		float invCount = 1.0f / (float)count;
+		for (int q = 0; q < N_QUAD; q++) {
+			// to four registers with the lanes being the VUs
+			__m128 v0 = _mm_loadu_ps(vuValues[(q << 2) + 0]);
+			__m128 v1 = _mm_loadu_ps(vuValues[(q << 2) + 1]);
+			__m128 v2 = _mm_loadu_ps(vuValues[(q << 2) + 2]);
+			__m128 v3 = _mm_loadu_ps(vuValues[(q << 2) + 3]);
+			_MM_TRANSPOSE4_PS(v0, v1, v2, v3);// now organized according to VuIds
+			
+			// RMS (same operation order as VuMeterAllDual::process() when decimation is 1)
+			simd::float_4 rmsL = v2;
+			simd::float_4 rmsR = v3;
+			rmsL += (squareAcc[0][q] * invCount - rmsL) * VuMeterAllDual::lambda * deltaTimeAcc;
+			rmsR += (squareAcc[1][q] * invCount - rmsR) * VuMeterAllDual::lambda * deltaTimeAcc;
+			
+			// PEAK
+			simd::float_4 peakL = v0;
+			simd::float_4 peakR = v1;
+			peakL = simd::ifelse(peakAcc[0][q] >= peakL, peakAcc[0][q], peakL + (peakAcc[0][q] - peakL) * VuMeterAllDual::lambda * deltaTimeAcc);
+			peakR = simd::ifelse(peakAcc[1][q] >= peakR, peakAcc[1][q], peakR + (peakAcc[1][q] - peakR) * VuMeterAllDual::lambda * deltaTimeAcc);
+			
+			v0 = peakL.v;
+			v1 = peakR.v;
+			v2 = rmsL.v;
+			v3 = rmsR.v;
+			_MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+			_mm_storeu_ps(vuValues[(q << 2) + 0], v0);
+			_mm_storeu_ps(vuValues[(q << 2) + 1], v1);
+			_mm_storeu_ps(vuValues[(q << 2) + 2], v2);
+			_mm_storeu_ps(vuValues[(q << 2) + 3], v3);
+			
+			for (int i = 0; i < 2; i++) {
+				peakAcc[i][q] = 0.0f;
+				squareAcc[i][q] = 0.0f;
+			}
+		}
+		count = 0;
+		countSamples = 0;
+	}
+};
+
+
 
 // VuMeter displays (and colors)
 // ----------------------------------------------------------------------------
@@ -131,6 +243,7 @@ struct VuMeterBase : LightWidget {//OpaqueWidget {
 	float redThreshold;// in px, before vertical inversion
 	int colorTheme;
 	float hardRedVoltage = 10.0f;
+	bool drawnByBridge = false;// set by VuMeterBridge::addMeter()
 
 	
 	VuMeterBase() {
@@ -237,6 +350,31 @@ struct VuMeterBassMono : VuMeterTrack {
 };
 
 
+// Meter bridge for all the track-like VUs of a panel
+// --------------------
+
+// draws its VUs instead of them drawing themselves, with the rects of all VUs merged into one fill per paint, 
+//   so the number of fills does not depend on the number of VUs; the VUs must all have the same height and 
+//   vertical position, and the bridge must have the same parent as the VUs and be at (0, 0)
+struct VuMeterBridge : TransparentWidget {
+	// rects are batched by pass (peak, rms, peak hold), part (green, yellow-red) and color (VU theme, or numVuThemes for ghost gray)
+	static const int numBatchColors = numVuThemes + 1;
+	static const int numBatches = 3 * 2 * numBatchColors;
+	
+	std::vector<VuMeterBase*> meters;
+	std::vector<Rect> batchRects[numBatches];
+	
+	
+	void addMeter(VuMeterBase* meter) {
+		meter->drawnByBridge = true;
+		meters.push_back(meter);
+	}
+	
+	void addVuRects(int pass, int color, VuMeterBase* meter, float vuValue, float posX);
+	void draw(const DrawArgs &args) override;
+};
+
+
 // Menus
 // ----------------------------------------------------------------------------
 
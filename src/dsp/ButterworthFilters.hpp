@@ -85,3 +85,76 @@ class ButterworthThirdOrder {
 		return f2.process(f1.process(in));
 	}
 };
+
+
+class QuattroButterworthSecondOrder {
+	// four independent second-order filters, one per float_4 lane, each with its own coefficients
+	simd::float_4 b[3];// coefficients b0, b1 and b2
+	simd::float_4 a[3 - 1];// coefficients a1 and a2
+	simd::float_4 x[3 - 1];
+	simd::float_4 y[3 - 1];
+	float midCoef = float(M_SQRT2);
+	
+	public:
+	
+	void setMidCoef(float _midCoef) {
+		midCoef = _midCoef;
+	}
+	
+	void reset() {
+		for (int i = 0; i < 2; i++) {
+			x[i] = 0.0f;
+			y[i] = 0.0f;
+		}
+	}
+
+	void setParameters(int i, bool isHighPass, float nfc) {// i: lane (0 to 3), nfc: normalized freq
+		// see ButterworthSecondOrder::setParameters()
+		float nfcw = nfc < 0.025f ? float(M_PI) * nfc : std::tan(float(M_PI) * std::min(0.499f, nfc));
+
+		float acst = nfcw * nfcw + nfcw * midCoef + 1.0f;
+		a[0][i] = 2.0f * (nfcw * nfcw - 1.0f) / acst;
+		a[1][i] = (nfcw * nfcw - nfcw * midCoef + 1.0f) / acst;
+		
+		float hbcst = 1.0f / acst;
+		float lbcst = hbcst * nfcw * nfcw;			
+		b[0][i] = isHighPass ? hbcst : lbcst;
+		b[1][i] = (isHighPass ? -hbcst : lbcst) * 2.0f;
+		b[2][i] = b[0][i];
+	}
+	
+	simd::float_4 process(simd::float_4 in) {
+		simd::float_4 out = b[0] * in + b[1] * x[0] + b[2] * x[1] - a[0] * y[0] - a[1] * y[1];
+		x[1] = x[0];
+		x[0] = in;
+		y[1] = y[0];
+		y[0] = out;
+		return out;
+	}
+};
+
+
+class QuattroButterworthThirdOrder {
+	QuattroFirstOrderFilter f1;
+	QuattroButterworthSecondOrder f2;
+	
+	public:
+	
+	QuattroButterworthThirdOrder() {
+		f2.setMidCoef(1.0f);
+	}
+	
+	void reset() {
+		f1.reset();
+		f2.reset();
+	}
+	
+	void setParameters(int i, bool isHighPass, float nfc) {// i: lane (0 to 3), nfc: normalized freq
+		f1.setParameters(i, isHighPass, nfc);
+		f2.setParameters(i, isHighPass, nfc);
+	}
+	
+	simd::float_4 process(simd::float_4 in) {
+		return f2.process(f1.process(in));
+	}
+};
@@ -77,3 +77,37 @@ class FirstOrderStereoFilter : public FirstOrderCoefficients {
 		out[1] = y[1];
 	}
 };
+
+
+class QuattroFirstOrderFilter {
+	// four independent first-order filters, one per float_4 lane, each with its own coefficients
+	simd::float_4 b[2];// coefficients b0, b1
+	simd::float_4 a;// coefficient a1
+	simd::float_4 x;
+	simd::float_4 y;
+	
+	public: 
+		
+	void reset() {
+		x = 0.0f;
+		y = 0.0f;
+	}
+
+	void setParameters(int i, bool isHighPass, float nfc) {// i: lane (0 to 3), nfc: normalized freq
+		// see FirstOrderCoefficients::setParameters()
+		float nfcw = nfc < 0.025f ? float(M_PI) * nfc : std::tan(float(M_PI) * std::min(0.499f, nfc));
+		
+		a[i] = (nfcw - 1.0f) / (nfcw + 1.0f);
+		
+		float hbcst = 1.0f / (1.0f + nfcw);
+		float lbcst = 1.0f - hbcst;
+		b[0][i] = isHighPass ? hbcst : lbcst;
+		b[1][i] = isHighPass ? -hbcst : lbcst;
+	}
+
+	simd::float_4 process(simd::float_4 in) {
+		y = b[0] * in + b[1] * x - a * y;
+		x = in;
+		return y;
+	}
+};
@@ -0,0 +1,288 @@
+//***********************************************************************************************
+//Mind Meld Modular: Modules for VCV Rack by Steve Baker and Marc Boulé
+//
+//Loudness (ITU-R BS.1770-4 / EBU R 128) and true-peak meter
+//See ./LICENSE.md for all licenses
+//***********************************************************************************************
+
+
+#pragma once
+
+#include <atomic>
+
+
+// Values published by the loudness meter, in LUFS and dBTP; minLoudness when there is nothing to show
+struct LoudnessValues {
+	float momentary;// 400 ms window
+	float shortTerm;// 3 s window
+	float integrated;// gated, since the last reset
+	float truePeak;// max since the last reset
+};
+
+
+// Stereo loudness and true-peak meter for the audio thread. The K-weighting is two biquads, processed as one float_4
+//   biquad where lanes 0-1 are the first stage for L-R and lanes 2-3 the second stage for L-R fed with the previous output
+//   of lanes 0-1 (one sample of latency, irrelevant here). The true-peak is a 4x oversampling polyphase FIR where the lanes
+//   of a float_4 are the four phases. Energies are integrated in 100 ms blocks, and at the end of each block the loudness
+//   values are computed and published through a sequence counter, so the UI reads a consistent set without locking.
+class LoudnessMeter {
+	static const int TP_TAPS = 12;// per phase, so 48 taps at 4x
+	static const int ST_BLOCKS = 30;// 3 s of 100 ms blocks
+	static const int M_BLOCKS = 4;// 400 ms of 100 ms blocks, also the gating block of the integrated loudness
+	static const int HIST_BINS = 800;// 0.1 LU bins of the gating blocks, from -70 to +10 LUFS
+	static constexpr float histMin = -70.0f;// absolute gate in LUFS
+	static constexpr float fullScaleVoltage = 10.0f;// 0 dBFS, same as the master VU
+
+	// K-weighting
+	simd::float_4 b0, b1, b2, a1, a2;
+	simd::float_4 z1, z2;
+	simd::float_4 kOut;
+	simd::float_4 energyAcc;// only lanes 2-3 are K-weighted
+
+	// true-peak
+	simd::float_4 tpCoeffs[TP_TAPS];// lanes are the phases
+	float tpHist[2][TP_TAPS * 2];// history written twice so that it is always contiguous from tpHead (newest) onwards
+	int tpHead;
+	simd::float_4 tpAcc;// max of both channels, lanes are the phases
+	float truePeakMax;// linear
+
+	// blocks
+	int blockSize;
+	int blockCount;
+	double blockEnergy[ST_BLOCKS];// mean square per block, sum of the channels
+	int blockHead;
+	int filledBlocks;// up to M_BLOCKS, the first gating blocks are not complete
+	uint32_t histCount[HIST_BINS];
+	double histEnergy[HIST_BINS];
+	uint32_t gatedCount;// gating blocks above the absolute gate
+	double gatedEnergy;
+
+	// publishing
+	std::atomic<uint32_t> seq;
+	LoudnessValues values;
+
+
+	public:
+
+	static constexpr float minLoudness = -120.0f;
+	std::atomic<bool> resetIntegratedRequest;// set by the UI, the audio thread resets the integrated loudness and true-peak max
+
+
+	LoudnessMeter() {
+		seq.store(0);
+		resetIntegratedRequest.store(false);
+		setSampleRate(44100.0f);
+	}
+
+
+	void setSampleRate(float sampleRate) {
+		// K-weighting coefficients for any sample rate (the standard gives them at 48 kHz only)
+		// stage 1: high shelf, +4 dB above 1.5 kHz
+		float K = std::tan(float(M_PI) * 1681.974450955533f / sampleRate);
+		float Q = 0.7071752369554196f;
+		float Vh = std::pow(10.0f, 3.999843853973347f / 20.0f);
+		float Vb = std::pow(Vh, 0.4996667741545416f);
+		float norm = 1.0f / (1.0f + K / Q + K * K);
+		b0[0] = b0[1] = (Vh + Vb * K / Q + K * K) * norm;
+		b1[0] = b1[1] = 2.0f * (K * K - Vh) * norm;
+		b2[0] = b2[1] = (Vh - Vb * K / Q + K * K) * norm;
+		a1[0] = a1[1] = 2.0f * (K * K - 1.0f) * norm;
+		a2[0] = a2[1] = (1.0f - K / Q + K * K) * norm;
+		// stage 2: RLB high pass at 38 Hz (numerator is not normalized, as in the standard)
+		K = std::tan(float(M_PI) * 38.13547087602444f / sampleRate);
+		Q = 0.5003270373238773f;
+		norm = 1.0f / (1.0f + K / Q + K * K);
+		b0[2] = b0[3] = 1.0f;
+		b1[2] = b1[3] = -2.0f;
+		b2[2] = b2[3] = 1.0f;
+		a1[2] = a1[3] = 2.0f * (K * K - 1.0f) * norm;
+		a2[2] = a2[3] = (1.0f - K / Q + K * K) * norm;
+
+		// true-peak interpolator: Blackman-Harris windowed sinc, cutoff at the original Nyquist;
+		//   phase 0 is the original sample (delayed by TP_TAPS / 2), each phase is normalized for unity gain at DC
+		for (int k = 0; k < TP_TAPS; k++) {
+			for (int p = 0; p < 4; p++) {
+				int n = k * 4 + p;
+				float x = (float)(n - TP_TAPS * 2) * 0.25f;
+				float sinc = x == 0.0f ? 1.0f : std::sin(float(M_PI) * x) / (float(M_PI) * x);
+				float w = 2.0f * float(M_PI) * (float)n / (float)(TP_TAPS * 4);
+				float win = 0.35875f - 0.48829f * std::cos(w) + 0.14128f * std::cos(2.0f * w) - 0.01168f * std::cos(3.0f * w);
+				tpCoeffs[k][p] = sinc * win;
+			}
+		}
+		simd::float_4 dcGain = 0.0f;
+		for (int k = 0; k < TP_TAPS; k++) {
+			dcGain += tpCoeffs[k];
+		}
+		for (int k = 0; k < TP_TAPS; k++) {
+			tpCoeffs[k] /= dcGain;
+		}
+
+		blockSize = std::max((int)(sampleRate * 0.1f + 0.5f), 1);
+		reset();
+	}
+
+
+	void reset() {
+		z1 = 0.0f;
+		z2 = 0.0f;
+		kOut = 0.0f;
+		energyAcc = 0.0f;
+		for (int c = 0; c < 2; c++) {
+			for (int i = 0; i < TP_TAPS * 2; i++) {
+				tpHist[c][i] = 0.0f;
+			}
+		}
+		tpHead = 0;
+		tpAcc = 0.0f;
+		blockCount = 0;
+		for (int i = 0; i < ST_BLOCKS; i++) {
+			blockEnergy[i] = 0.0;
+		}
+		blockHead = 0;
+		filledBlocks = 0;
+		resetIntegrated();
+	}
+
+
+	// audio thread
+
+	void process(const float* sigs) {// L and R, in volts
+		simd::float_4 in(sigs[0], sigs[1], 0.0f, 0.0f);
+		in *= (1.0f / fullScaleVoltage);
+
+		// K-weighting, transposed direct form II
+		simd::float_4 x = _mm_movelh_ps(in.v, kOut.v);// L, R, stage 1 L, stage 1 R
+		kOut = b0 * x + z1;
+		z1 = b1 * x - a1 * kOut + z2;
+		z2 = b2 * x - a2 * kOut;
+		energyAcc += kOut * kOut;
+
+		// true-peak, the four interpolated samples of each channel at once
+		tpHist[0][tpHead] = tpHist[0][tpHead + TP_TAPS] = in[0];
+		tpHist[1][tpHead] = tpHist[1][tpHead + TP_TAPS] = in[1];
+		const float* hL = &tpHist[0][tpHead];// newest first
+		const float* hR = &tpHist[1][tpHead];
+		simd::float_4 tpL = 0.0f;
+		simd::float_4 tpR = 0.0f;
+		for (int k = 0; k < TP_TAPS; k++) {
+			tpL += tpCoeffs[k] * hL[k];
+			tpR += tpCoeffs[k] * hR[k];
+		}
+		tpAcc = simd::fmax(tpAcc, simd::fmax(simd::abs(tpL), simd::abs(tpR)));
+		tpHead = tpHead == 0 ? TP_TAPS - 1 : tpHead - 1;
+
+		blockCount++;
+		if (blockCount >= blockSize) {
+			endBlock();
+		}
+	}
+
+
+	// UI thread
+
+	bool read(LoudnessValues* dest) {// returns false when the audio thread kept publishing during the read
+		for (int tries = 0; tries < 4; tries++) {
+			uint32_t s0 = seq.load(std::memory_order_acquire);
+			if ((s0 & 0x1) != 0) {
+				continue;
+			}
+			*dest = values;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (seq.load(std::memory_order_relaxed) == s0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	private:
+
+	static float toLufs(double meanSquare) {
+		return meanSquare > 1e-12 ? (float)(-0.691 + 10.0 * std::log10(meanSquare)) : minLoudness;
+	}
+
+	void resetIntegrated() {
+		for (int i = 0; i < HIST_BINS; i++) {
+			histCount[i] = 0;
+			histEnergy[i] = 0.0;
+		}
+		gatedCount = 0;
+		gatedEnergy = 0.0;
+		truePeakMax = 0.0f;
+		publish(minLoudness, minLoudness, minLoudness, minLoudness);
+	}
+
+	void endBlock() {
+		if (resetIntegratedRequest.load(std::memory_order_relaxed)) {
+			resetIntegratedRequest.store(false, std::memory_order_relaxed);
+			resetIntegrated();
+		}
+
+		blockEnergy[blockHead] = ((double)energyAcc[2] + (double)energyAcc[3]) / (double)blockCount;
+		blockHead = (blockHead + 1) % ST_BLOCKS;
+		energyAcc = 0.0f;
+		blockCount = 0;
+
+		// momentary and short-term (blocks before the first ones are silent)
+		double mEnergy = 0.0;
+		double stEnergy = 0.0;
+		for (int i = 1; i <= ST_BLOCKS; i++) {
+			double e = blockEnergy[(blockHead + ST_BLOCKS - i) % ST_BLOCKS];
+			if (i <= M_BLOCKS) {
+				mEnergy += e;
+			}
+			stEnergy += e;
+		}
+		mEnergy *= (1.0 / M_BLOCKS);
+		stEnergy *= (1.0 / ST_BLOCKS);
+		float momentary = toLufs(mEnergy);
+		float shortTerm = toLufs(stEnergy);
+
+		// integrated: the momentary window with 75% overlap is the gating block; histogram of the blocks above the absolute gate,
+		//   where the relative gate is applied per bin
+		if (filledBlocks < M_BLOCKS) {
+			filledBlocks++;
+		}
+		if (momentary > histMin && filledBlocks >= M_BLOCKS) {
+			int bin = std::min((int)((momentary - histMin) * 10.0f), HIST_BINS - 1);
+			histCount[bin]++;
+			histEnergy[bin] += mEnergy;
+			gatedCount++;
+			gatedEnergy += mEnergy;
+		}
+		float integrated = minLoudness;
+		if (gatedCount > 0) {
+			float relGate = toLufs(gatedEnergy / (double)gatedCount) - 10.0f;
+			int bin = std::max((int)std::ceil((relGate - histMin) * 10.0f), 0);
+			uint32_t count = 0;
+			double energy = 0.0;
+			for (; bin < HIST_BINS; bin++) {
+				count += histCount[bin];
+				energy += histEnergy[bin];
+			}
+			if (count > 0) {
+				integrated = toLufs(energy / (double)count);
+			}
+		}
+
+		// true-peak
+		truePeakMax = std::max(truePeakMax, std::max(std::max(tpAcc[0], tpAcc[1]), std::max(tpAcc[2], tpAcc[3])));
+		tpAcc = 0.0f;
+		float truePeak = truePeakMax > 1e-6f ? 20.0f * std::log10(truePeakMax) : minLoudness;
+
+		publish(momentary, shortTerm, integrated, truePeak);
+	}
+
+	void publish(float momentary, float shortTerm, float integrated, float truePeak) {
+		uint32_t s = seq.load(std::memory_order_relaxed);
+		seq.store(s + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		values.momentary = momentary;
+		values.shortTerm = shortTerm;
+		values.integrated = integrated;
+		values.truePeak = truePeak;
+		seq.store(s + 2, std::memory_order_release);
+	}
+};
@@ -116,6 +116,62 @@ class QuattroBiQuadCoeff {
 	}
 
 
+	// same coefficients as setParameters() above for the four biquads at once (lanes are the biquads, types has four entries),
+	//   with tanPiFast() instead of std::tan(); dest[0..4] get b0, b1, b2, a1, a2
+	static void calcCoefficients(simd::float_4* dest, Type* types, simd::float_4 nfc, simd::float_4 V, simd::float_4 Q) {
+		simd::float_4 lowShelf = simd::float_4(types[0] == LOWSHELF, types[1] == LOWSHELF, types[2] == LOWSHELF, types[3] == LOWSHELF) != 0.0f;
+		simd::float_4 highShelf = simd::float_4(types[0] == HIGHSHELF, types[1] == HIGHSHELF, types[2] == HIGHSHELF, types[3] == HIGHSHELF) != 0.0f;
+		simd::float_4 shelf = lowShelf | highShelf;
+		
+		simd::float_4 K = simd::ifelse(nfc < 0.025f, float(M_PI) * nfc, tanPiFast(simd::fmin(0.499f, nfc)));
+		simd::float_4 K2 = K * K;
+		simd::float_4 alpha = K / simd::ifelse(shelf, simd::sqrt(Q) / float(M_SQRT2), Q);
+		
+		// a cut (V < 1) is the inverse of the boost by G = 1 / V, so numerator and denominator swap
+		simd::float_4 boost = V >= 1.0f;
+		simd::float_4 G = simd::ifelse(boost, V, 1.0f / V);
+		simd::float_4 sqrtG = simd::sqrt(G);
+		
+		// gain polynomial: c + m * alpha + e * K2, 2 * (e * K2 - c), c - m * alpha + e * K2
+		simd::float_4 c = simd::ifelse(highShelf, G, 1.0f);
+		simd::float_4 m = simd::ifelse(shelf, sqrtG, G);
+		simd::float_4 e = simd::ifelse(lowShelf, G, 1.0f);
+		simd::float_4 p0 = c + m * alpha + e * K2;
+		simd::float_4 p1 = 2.0f * (e * K2 - c);
+		simd::float_4 p2 = c - m * alpha + e * K2;
+		
+		// unity polynomial
+		simd::float_4 d0 = 1.0f + alpha + K2;
+		simd::float_4 d1 = 2.0f * (K2 - 1.0f);
+		simd::float_4 d2 = 1.0f - alpha + K2;
+		
+		simd::float_4 norm = 1.0f / simd::ifelse(boost, d0, p0);
+		dest[0] = simd::ifelse(boost, p0, d0) * norm;
+		dest[1] = simd::ifelse(boost, p1, d1) * norm;
+		dest[2] = simd::ifelse(boost, p2, d2) * norm;
+		dest[3] = simd::ifelse(boost, d1, p1) * norm;
+		dest[4] = simd::ifelse(boost, d2, p2) * norm;
+	}
+
+
+	void setCoefficients(simd::float_4* src) {// src[0..4]: b0, b1, b2, a1, a2
+		b0 = src[0];
+		b1 = src[1];
+		b2 = src[2];
+		a1 = src[3];
+		a2 = src[4];
+	}
+
+
+	void getCoefficients(simd::float_4* dest) {// dest[0..4] get b0, b1, b2, a1, a2 (lanes are the four biquads)
+		dest[0] = b0;
+		dest[1] = b1;
+		dest[2] = b2;
+		dest[3] = a1;
+		dest[4] = a2;
+	}
+
+
 	// add all 4 values in return vector to get total gain (dB) since each float is gain (dB) of one biquad
 	simd::float_4 getFrequencyResponse(float f) {
 		// Compute sum(b_k z^-k) / sum(a_k z^-k) where z = e^(i s)
@@ -144,44 +200,122 @@ class QuattroBiQuadCoeff {
 		simd::float_4 norm = simd::hypot(num[0] / denom,  num[1] / denom);
 		return 20.0f * simd::log10(norm);// return in dB
 	}
+
+	
+	// gain (dB) of biquad b alone at n frequencies (n multiple of 4), four frequencies at a time
+	// zs[4 * n]: precalculated z^-1 = e^(-i s) and z^-2 = e^(-2i s) of each frequency, as n real of z^-1, n imag of z^-1, n real of z^-2, n imag of z^-2
+	void getFrequencyResponse(int b, float* destDb, const float* zs, int n) {
+		simd::float_4 b0b = b0[b];
+		simd::float_4 b1b = b1[b];
+		simd::float_4 b2b = b2[b];
+		simd::float_4 a1b = a1[b];
+		simd::float_4 a2b = a2[b];
+		for (int i = 0; i < n; i += 4) {
+			simd::float_4 z1Re = simd::float_4::load(&zs[i]);
+			simd::float_4 z1Im = simd::float_4::load(&zs[n + i]);
+			simd::float_4 z2Re = simd::float_4::load(&zs[2 * n + i]);
+			simd::float_4 z2Im = simd::float_4::load(&zs[3 * n + i]);
+			simd::float_4 bSumRe = b0b + b1b * z1Re + b2b * z2Re;
+			simd::float_4 bSumIm = b1b * z1Im + b2b * z2Im;
+			simd::float_4 aSumRe = 1.0f + a1b * z1Re + a2b * z2Re;
+			simd::float_4 aSumIm = a1b * z1Im + a2b * z2Im;
+			simd::float_4 norm2 = (bSumRe * bSumRe + bSumIm * bSumIm) / (aSumRe * aSumRe + aSumIm * aSumIm);
+			(10.0f * simd::log10(norm2)).store(&destDb[i]);// 10 since norm is squared
+		}
+	}
+};
+
+
+
+// State of one channel of the four pipelined biquads, for each form; the output y0 is kept by TQuattroBiQuad
+template <bool TDF2>
+struct QuattroBiQuadState;
+
+template <>
+struct QuattroBiQuadState<false> {// direct form I: input/output shift registers
+	simd::float_4 x0, x1, x2;
+	simd::float_4 y1, y2;
+	
+	void clear() {
+		x0 = 0.0f;
+		x1 = 0.0f;
+		x2 = 0.0f;
+		y1 = 0.0f;
+		y2 = 0.0f;
+	}
+	
+	void bypass(simd::float_4 u) {
+		x0 = u;
+	}
+	
+	simd::float_4 process(simd::float_4 u, simd::float_4 y0, simd::float_4 b0, simd::float_4 b1, simd::float_4 b2, simd::float_4 a1, simd::float_4 a2) {// returns the new y0
+		x2 = x1;
+		x1 = x0;
+		x0 = u;
+		y2 = y1;
+		y1 = y0;
+		return b0 * x0 + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;// https://en.wikipedia.org/wiki/Infinite_impulse_response
+	}
+};
+
+template <>
+struct QuattroBiQuadState<true> {// transposed direct form II: two state vectors
+	simd::float_4 s1, s2;
+	
+	void clear() {
+		s1 = 0.0f;
+		s2 = 0.0f;
+	}
+	
+	void bypass(simd::float_4 u) {}
+	
+	simd::float_4 process(simd::float_4 u, simd::float_4 y0, simd::float_4 b0, simd::float_4 b1, simd::float_4 b2, simd::float_4 a1, simd::float_4 a2) {// returns the new y0
+		y0 = b0 * u + s1;
+		s1 = b1 * u - a1 * y0 + s2;
+		s2 = b2 * u - a2 * y0;
+		return y0;
+	}
 };
 
 
 
 // Four stereo biquad filters in pipeline series, where each biquad's parameters can be set separately
-class QuattroBiQuad : public QuattroBiQuadCoeff {
+//   TDF2: false for direct form I, true for transposed direct form II (two state vectors per channel instead 
+//   of five; same rounding error as direct form I when measured on a 25 Hz low shelf, so not used by TrackEq)
+template <bool TDF2 = false>
+class TQuattroBiQuad : public QuattroBiQuadCoeff {
 	
-	// input/output shift registers
-	simd::float_4 x0L, x0R;// input is x0[0]
-	simd::float_4 x1L, x1R;
-	simd::float_4 x2L, x2R;
-	simd::float_4 y0L, y0R;// output is y0[3]
-	simd::float_4 y1L, y1R;
-	simd::float_4 y2L, y2R;
+	simd::float_4 y0L, y0R;// output is y0[3], and the next input vector is {in, y0[0], y0[1], y0[2]}
+	QuattroBiQuadState<TDF2> stateL, stateR;
 	
 	// other
 	bool optResetDone;
 	int8_t gainsDifferentThanOne; // 4 ls bits are bool bits, when all zero, can bypass y0 math
+	simd::float_4 coeffTargets[5];// b0, b1, b2, a1, a2 at the end of the coefficient ramp
+	simd::float_4 coeffSteps[5];
+	int coeffRampCount;// samples left in the coefficient ramp, 0 when not ramping
+	bool coeffsValid;// false after reset() until the first vector setParameters(), which must not ramp from unset coefficients
+	
+	
+	// returns {in, v[0], v[1], v[2]}, which is the input vector of the pipelined biquads
+	static simd::float_4 shiftIn(simd::float_4 v, float in) {
+		__m128 shifted = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v.v), 4));
+		return _mm_move_ss(shifted, _mm_set_ss(in));
+	}
 	
 	
 	public:
 
 
 	void reset() {
-		x0L = 0.0f;
-		x0R = 0.0f;
-		x1L = 0.0f;
-		x1R = 0.0f;
-		x2L = 0.0f;
-		x2R = 0.0f;
 		y0L = 0.0f;
 		y0R = 0.0f;
-		y1L = 0.0f;
-		y1R = 0.0f;
-		y2L = 0.0f;
-		y2R = 0.0f;
+		stateL.clear();
+		stateR.clear();
 		gainsDifferentThanOne = 0xF;	
 		optResetDone = false;
+		coeffsValid = false;
+		coeffRampCount = 0;
 	}
 	
 	
@@ -197,60 +331,90 @@ class QuattroBiQuad : public QuattroBiQuadCoeff {
 		else {
 			gainsDifferentThanOne |= (0x1 << i);
 		}
+		if (coeffRampCount != 0) {
+			setCoefficients(coeffTargets);
+			coeffRampCount = 0;
+		}
 		QuattroBiQuadCoeff::setParameters(i, type, f, V, Q);
 	}
 	
+	
+	// sets the four biquads at once, see calcCoefficients(); when rampLength > 1, the coefficients move 
+	//   linearly to their new values over that many samples, one step per call to stepCoefficients()
+	//   (no ramp from or to the all-gains-one bypass, since the biquad states are zero or about to be cleared in that case)
+	void setParameters(Type* types, simd::float_4 f, simd::float_4 V, simd::float_4 Q, int rampLength = 1) {
+		bool wasBypassed = !coeffsValid || getGainsAllOne();
+		gainsDifferentThanOne = simd::movemask(V != 1.0f);
+		coeffsValid = true;
+		calcCoefficients(coeffTargets, types, f, V, Q);
+		if (rampLength <= 1 || wasBypassed || gainsDifferentThanOne == 0) {
+			setCoefficients(coeffTargets);
+			coeffRampCount = 0;
+		}
+		else {
+			float rampStep = 1.0f / (float)rampLength;
+			coeffSteps[0] = (coeffTargets[0] - b0) * rampStep;
+			coeffSteps[1] = (coeffTargets[1] - b1) * rampStep;
+			coeffSteps[2] = (coeffTargets[2] - b2) * rampStep;
+			coeffSteps[3] = (coeffTargets[3] - a1) * rampStep;
+			coeffSteps[4] = (coeffTargets[4] - a2) * rampStep;
+			coeffRampCount = rampLength;
+		}
+	}
+	
+	
+	bool stepCoefficients() {// call once per sample, returns true when the coefficients changed
+		if (coeffRampCount == 0) {
+			return false;
+		}
+		coeffRampCount--;
+		if (coeffRampCount == 0) {
+			setCoefficients(coeffTargets);// land exactly on the targets
+		}
+		else {
+			b0 += coeffSteps[0];
+			b1 += coeffSteps[1];
+			b2 += coeffSteps[2];
+			a1 += coeffSteps[3];
+			a2 += coeffSteps[4];
+		}
+		return true;
+	}
+	
+	
+	bool isCoeffRamping() {
+		return coeffRampCount != 0;
+	}
+	
+	
+	bool getGainsAllOne() {// process() bypasses the biquads when true
+		return gainsDifferentThanOne == 0 && coeffRampCount == 0;
+	}
+	
 
 	void process(float* out, float* in) {
-		if (gainsDifferentThanOne == 0) {
+		simd::float_4 uL = shiftIn(y0L, in[0]);
+		simd::float_4 uR = shiftIn(y0R, in[1]);
+		if (getGainsAllOne()) {
 			if (!optResetDone) {
-				x2L = 0.0f;
-				x2R = 0.0f;
-				x1L = 0.0f;
-				x1R = 0.0f;
-				y2L = 0.0f;
-				y2R = 0.0f;
-				y1L = 0.0f;
-				y1R = 0.0f;
+				stateL.clear();
+				stateR.clear();
 				optResetDone = true;
 			}
-			
-			x0L[0] = in[0];
-			x0L[1] = y0L[0];
-			x0L[2] = y0L[1];
-			x0L[3] = y0L[2];
-			y0L = x0L;
-			
-			x0R[0] = in[1];
-			x0R[1] = y0R[0];
-			x0R[2] = y0R[1];
-			x0R[3] = y0R[2];
-			y0R = x0R;
+			stateL.bypass(uL);
+			stateR.bypass(uR);
+			y0L = uL;
+			y0R = uR;
 		}
 		else {
 			optResetDone = false;
-			x2L = x1L;
-			x1L = x0L;
-			x0L[0] = in[0];
-			x0L[1] = y0L[0];
-			x0L[2] = y0L[1];
-			x0L[3] = y0L[2];
-			y2L = y1L;
-			y1L = y0L;
-			y0L = b0 * x0L + b1 * x1L + b2 * x2L - a1 * y1L - a2 * y2L;// https://en.wikipedia.org/wiki/Infinite_impulse_response
-
-			x2R = x1R;
-			x1R = x0R;
-			x0R[0] = in[1];
-			x0R[1] = y0R[0];
-			x0R[2] = y0R[1];
-			x0R[3] = y0R[2];
-			y2R = y1R;
-			y1R = y0R;
-			y0R = b0 * x0R + b1 * x1R + b2 * x2R - a1 * y1R - a2 * y2R;// https://en.wikipedia.org/wiki/Infinite_impulse_response
+			y0L = stateL.process(uL, y0L, b0, b1, b2, a1, a2);
+			y0R = stateR.process(uR, y0R, b0, b1, b2, a1, a2);
 		}
 		
 		out[0] = y0L[3];
 		out[1] = y0R[3];
 	}	
 };
+
+typedef TQuattroBiQuad<> QuattroBiQuad;